@@ -113,6 +113,8 @@ var progressBar;
 var progressBarVerify;
 var lastWinnerContainer;
 var lastWinner;
+var roundTimelineContainer;
+var roundTimeline;
 var confirmedSound = new Audio("sounds/alert.mp3");
 var playConfirmationSound = true;
 var iconConfirmationSound;
@@ -541,6 +543,23 @@ function setLastWinner(winner) {
     }
 }
 
+function setRoundTimeline(timeline) {
+    roundTimeline.empty();
+
+    timeline["events"].forEach(function (event) {
+        var stage = event["stage"];
+
+        if (event["label"])
+            stage += " <small class='text-muted'>" + event["label"] + "</small>";
+
+        roundTimeline.append("<tr><td>" + stage + "</td><td>" + event["time"] + "</td><td>" + event["readQueue"] +
+            "</td><td>" + event["verifyQueue"] + "</td><td>" + event["bufferUsed"] + "</td></tr>");
+    });
+
+    $("#roundTimelineHeight").html(timeline["blockheight"]);
+    roundTimelineContainer.show();
+}
+
 function deActivateConfirmationSound(on) {
     playConfirmationSound = on;
 
@@ -715,6 +734,9 @@ function connectBlock() {
                 case "lastWinner":
                     setLastWinner(response);
                     break;
+                case "round timeline":
+                    setRoundTimeline(response);
+                    break;
                 case "blocksWonUpdate":
                     wonBlocks.html(reponse["blocksWon"]);
                     break;
@@ -865,6 +887,8 @@ function initBlock() {
     progressBarVerify = $("#progressBarVerify");
     lastWinnerContainer = $("#lastWinnerContainer");
     lastWinner = $("#lastWinner");
+    roundTimelineContainer = $("#roundTimelineContainer");
+    roundTimeline = $("#roundTimeline");
     iconConfirmationSound = $("#iconConfirmationSound");
     avgDeadline = $("#avgDeadline");
     deadlinePerformance = $("#deadlinePerformance");
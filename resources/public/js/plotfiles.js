@@ -13,6 +13,7 @@ window.onload = function (evt) {
     $("#btnPlots").addClass('active');
     parsePlots();
     fillDirs();
+    loadDisks();
     connect(connectCallback);
 }
 
@@ -32,6 +33,10 @@ function connectCallback(msg) {
                 resetLineTypes();
                 confirmedPlotfiles = [];
                 checkVersion(response["runningVersion"], response["onlineVersion"], response["runningBuild"]);
+                loadDisks();
+                break;
+            case "slow disk":
+                loadDisks();
                 break;
             case "plotdir-progress":
                 setDirProgress(response["dir"], response["value"]);
@@ -56,6 +61,35 @@ function connectCallback(msg) {
     }
 }
 
+function loadDisks() {
+    $.getJSON("/disks?rounds=0", function (data) {
+        var diskList = $("#diskList");
+        diskList.empty();
+
+        data["devices"].forEach(function (device) {
+            var status = device["slow"] ?
+                "<span class='badge badge-danger'>slow</span>" :
+                "<span class='badge badge-success'>ok</span>";
+
+            diskList.append("<tr" + (device["slow"] ? " class='table-danger'" : "") + "><td>" + device["device"] +
+                "</td><td>" + bytesToString(device["last"]) + "/s</td><td>" + bytesToString(device["baseline"]) +
+                "/s</td><td>" + device["rounds"] + "</td><td>" + status + "</td></tr>");
+        });
+    });
+}
+
+function bytesToString(bytes) {
+    var units = ["B", "KiB", "MiB", "GiB", "TiB"];
+    var unit = 0;
+
+    while (bytes >= 1024 && unit < units.length - 1) {
+        bytes /= 1024;
+        ++unit;
+    }
+
+    return bytes.toFixed(2) + " " + units[unit];
+}
+
 function createProgressBar(id) {
     var progresStr = '<div class="progress">';
     progresStr += '<div id="pb-' + id + '" class="progress-bar progress-bar-success progress-bar-striped bg-success" role="progressbar" aria-valuenow="100" aria-valuemin="0" aria-valuemax="100" style="width:100%">';
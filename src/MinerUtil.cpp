@@ -189,6 +189,8 @@ Burst::PlotCheckResult Burst::isValidPlotFile(const std::string& filePath)
 			if (nonceCount * Settings::plotSize != file.getSize())
 				return PlotCheckResult::Incomplete;
 
+#ifdef _WIN32
+			// the plotter writes its progress into an alternate data stream, only NTFS knows them
 			std::ifstream alternativeFileData{filePath + ":stream"};
 
 			if (alternativeFileData)
@@ -201,6 +203,7 @@ Burst::PlotCheckResult Burst::isValidPlotFile(const std::string& filePath)
 				if (*noncesWrote != nonceCount)
 					return PlotCheckResult::Incomplete;
 			}
+#endif
 		}
 
 		return PlotCheckResult::Ok;
@@ -549,24 +552,26 @@ Poco::JSON::Object Burst::createJsonNewBlock(const MinerData& data)
 	auto nBTimes = 0;
 	auto sumBTimes = 0.0;
 	auto maxBlockTime = 0ull;
-	const auto historicalBlockData = data.getAllHistoricalBlockData();
+	// only the rows of the blocks are read, the deadlines are aggregated by the database
+	auto historicalBlockData = data.getHistory(block.getBlockheight(), MinerConfig::getConfig().getMaxHistoricalBlocks());
+	std::reverse(historicalBlockData.begin(), historicalBlockData.end());
 
 	for (auto& historicalRoundTime : historicalBlockData)
 	{
-		const auto roundTime = historicalRoundTime->getRoundTime();
+		const auto roundTime = historicalRoundTime.roundTime;
 		if (roundTime > 0)
 		{
 			Poco::JSON::Array jsonRoundTimeHistory;
-			jsonRoundTimeHistory.add(std::to_string(historicalRoundTime->getBlockheight()));
+			jsonRoundTimeHistory.add(std::to_string(historicalRoundTime.height));
 			jsonRoundTimeHistory.add(std::to_string(roundTime));
 			roundTimeHistory.add(jsonRoundTimeHistory);
 			nRTimes++;
 			sumRTimes += roundTime;
 			if (roundTime > maxRoundTime) maxRoundTime = roundTime;
 		}
-		const auto blockTime = historicalRoundTime->getBlockTime();
+		const auto blockTime = historicalRoundTime.blockTime;
 		Poco::JSON::Array jsonBlockTimeHistory;
-		jsonBlockTimeHistory.add(std::to_string(historicalRoundTime->getBlockheight()));
+		jsonBlockTimeHistory.add(std::to_string(historicalRoundTime.height));
 		jsonBlockTimeHistory.add(std::to_string(blockTime));
 		blockTimeHistory.add(jsonBlockTimeHistory);
 		nBTimes++;
@@ -598,11 +603,11 @@ Poco::JSON::Object Burst::createJsonNewBlock(const MinerData& data)
 
 	for (auto& historicalDeadline : historicalBlockData)
 	{
-		if (historicalDeadline->getBestDeadline() != nullptr)
+		if (historicalDeadline.confirmedDeadlines > 0)
 		{
-			const auto thisDL = historicalDeadline->getBestDeadline()->getDeadline();
+			const auto thisDL = historicalDeadline.bestDeadline;
 			Poco::JSON::Array jsonBestDeadline;
-			jsonBestDeadline.add(std::to_string(historicalDeadline->getBlockheight()));
+			jsonBestDeadline.add(std::to_string(historicalDeadline.height));
 			jsonBestDeadline.add(std::to_string(thisDL));
 			bestDeadlines.add(jsonBestDeadline);
 
@@ -610,9 +615,9 @@ Poco::JSON::Object Burst::createJsonNewBlock(const MinerData& data)
 				maxDeadline = thisDL;
 
 			nDeadlines++;
-			if (historicalDeadline->getBlockTime() > meanRoundTime)
+			if (historicalDeadline.blockTime > meanRoundTime)
 			{
-				totalTarget += static_cast<double>(thisDL) / (18325193796.0f / static_cast<double>(historicalDeadline->getBasetarget()));
+				totalTarget += static_cast<double>(thisDL) / (18325193796.0f / static_cast<double>(historicalDeadline.baseTarget));
 				nTargets++;
 			}
 		}
@@ -640,9 +645,9 @@ Poco::JSON::Object Burst::createJsonNewBlock(const MinerData& data)
 
 		for (auto& historicalDeadline : historicalBlockData)
 		{
-			if (historicalDeadline->getBestDeadline() != nullptr)
+			if (historicalDeadline.confirmedDeadlines > 0)
 			{
-				const auto thisDl = historicalDeadline->getBestDeadline()->getDeadline();
+				const auto thisDl = historicalDeadline.bestDeadline;
 				auto bin = static_cast<Poco::UInt64>(floor(static_cast<double>(thisDl) / classWidth));
 
 				if (bin > nClasses - 1)
@@ -682,9 +687,9 @@ Poco::JSON::Object Burst::createJsonNewBlock(const MinerData& data)
 
 	for (auto& historicalDifficulty : historicalBlockData)
 	{
-		const auto blockDiff = 18325193796.0f / static_cast<float>(historicalDifficulty->getBasetarget());
+		const auto blockDiff = 18325193796.0f / static_cast<float>(historicalDifficulty.baseTarget);
 		Poco::JSON::Array jsonDifficultyHistory;
-		jsonDifficultyHistory.add(std::to_string(historicalDifficulty->getBlockheight()));
+		jsonDifficultyHistory.add(std::to_string(historicalDifficulty.height));
 		jsonDifficultyHistory.add(std::to_string(blockDiff));
 		difficultyHistory.add(jsonDifficultyHistory);
 		nDiffs++;
@@ -24,6 +24,7 @@
 #include "Declarations.hpp"
 #include "gpu/gpu_shell.hpp"
 #include "logging/Message.hpp"
+#include "logging/Tracing.hpp"
 
 namespace Burst
 {
@@ -45,21 +46,29 @@ namespace Burst
 			Poco::UInt64 minDeadlineIndex;
 
 			// allocate the memory for the gpu
+			TraceSpan allocSpan{"gpu allocate", "gpu"};
 			auto allocated = Shell::allocateMemory(reinterpret_cast<void**>(&gpuScoops), MemoryType::Buffer, nonces);
 			allocated = allocated && Shell::allocateMemory(reinterpret_cast<void**>(&gpuGensig), MemoryType::Gensig, 1);
 			allocated = allocated && Shell::allocateMemory(reinterpret_cast<void**>(&gpuDeadlines), MemoryType::Bytes, nonces * sizeof(Poco::UInt64));
 
 			ok = allocated;
+			allocSpan.end();
 
 			// copy the memory from RAM to gpu
+			TraceSpan copySpan{"gpu copy to device", "gpu"};
 			ok = ok && Shell::copyMemory(scoops, gpuScoops, MemoryType::Buffer, nonces, MemoryCopyDirection::ToDevice, stream);
 			ok = ok && Shell::copyMemory(&gensig, gpuGensig, MemoryType::Gensig, 1, MemoryCopyDirection::ToDevice, stream);
+			copySpan.end();
 
 			// calculate the deadlines on gpu
+			TraceSpan verifySpan{"gpu verify", "gpu"};
 			ok = ok && Shell::verify(gpuGensig, gpuScoops, gpuDeadlines, nonces, nonceStart, baseTarget, stream);
+			verifySpan.end();
 
 			// get the best deadline on gpu
+			TraceSpan minDeadlineSpan{"gpu min deadline", "gpu"};
 			ok = ok && Shell::getMinDeadline(gpuDeadlines, nonces, minDeadline, minDeadlineIndex, stream);
+			minDeadlineSpan.end();
 
 			// fetch the last error if there is one
 			ok = !Shell::getError(errorString);
@@ -76,6 +85,7 @@ namespace Burst
 			}
 
 			// give the memory on gpu free
+			TraceSpan freeSpan{"gpu free", "gpu"};
 			ok = ok && Shell::freeMemory(gpuScoops);
 			ok = ok && Shell::freeMemory(gpuGensig);
 			ok = ok && Shell::freeMemory(gpuDeadlines);
@@ -27,12 +27,19 @@
 #include "mining/MinerConfig.hpp"
 #include <memory>
 #include "MinerUtil.hpp"
+#include "Metrics.hpp"
+#include <chrono>
 
-Poco::NotificationQueue Burst::Message::messageQueue_;
-
-Burst::MessageNotification::MessageNotification(Poco::Logger& logger, Poco::Message message)
-	: message(std::move(message)), logger(&logger)
-{}
+Burst::MessageRing Burst::Message::ring_{8192};
+std::unique_ptr<Burst::Message::Dispatcher> Burst::Message::dispatcher_;
+Poco::Thread Burst::Message::dispatcherThread_{"Message-Dispatcher"};
+Poco::Event Burst::Message::dispatcherWakeUp_;
+Poco::FastMutex Burst::Message::dispatcherMutex_;
+std::atomic<bool> Burst::Message::asynchronous_{false};
+std::atomic<bool> Burst::Message::dispatcherIdle_{false};
+std::atomic<Burst::LogOverflowPolicy> Burst::Message::overflowPolicy_{LogOverflowPolicy::Block};
+std::atomic<Poco::UInt64> Burst::Message::dropped_{0};
+std::atomic<size_t> Burst::Message::written_{0};
 
 void Burst::Message::log(Poco::Message::Priority priority, TextType type, Poco::Logger& logger, const std::string& text, const char* file, int line, bool condition)
 {
@@ -61,50 +68,171 @@ void Burst::Message::logIntoFile(Poco::Message::Priority priority, TextType type
 	if (!MinerConfig::getConfig().isLogfileUsed())
 		return;
 
-	auto fileChannel = MinerLogger::getFileFormattingChannel();
+	LogRecord record;
+	record.logger = &logger;
+	record.message = create(priority, type, logger, text, file, line);
+	record.fileOnly = true;
+	enqueue(record);
+}
+
+void Burst::Message::startDispatcher()
+{
+	Poco::FastMutex::ScopedLock lock(dispatcherMutex_);
+
+	if (dispatcher_ != nullptr)
+		return;
 
-	// check if the filechannel is open and active
-	if (fileChannel != nullptr )
+	dispatcher_ = Dispatcher::create();
+	dispatcherThread_.start(*dispatcher_);
+	asynchronous_ = true;
+}
+
+void Burst::Message::stopDispatcher()
+{
+	Poco::FastMutex::ScopedLock lock(dispatcherMutex_);
+
+	if (dispatcher_ == nullptr)
+		return;
+
+	asynchronous_ = false;
+	dispatcher_->cancel();
+	dispatcherWakeUp_.set();
+	dispatcherThread_.join();
+	dispatcher_.reset();
+
+	// messages that were queued while the dispatcher was stopping
+	drain();
+}
+
+void Burst::Message::flush()
+{
+	// the dispatcher would wait for itself
+	if (!asynchronous_ || Poco::Thread::current() == &dispatcherThread_)
+		return;
+
+	const auto pushed = ring_.getPushed();
+	dispatcherWakeUp_.set();
+
+	while (asynchronous_ && written_ < pushed)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+void Burst::Message::setOverflowPolicy(const LogOverflowPolicy policy)
+{
+	overflowPolicy_ = policy;
+}
+
+void Burst::Message::enqueue(LogRecord& record)
+{
+	if (!asynchronous_)
 	{
-		// create the message..
-		auto message = create(priority, type, logger, text, file, line);
-		// ..and log it
-		fileChannel->log(message);
+		write(record);
+		return;
 	}
+
+	while (!ring_.tryPush(record))
+	{
+		if (overflowPolicy_ == LogOverflowPolicy::Drop)
+		{
+			++dropped_;
+			return;
+		}
+
+		// the dispatcher was stopped in the meantime
+		if (!asynchronous_)
+		{
+			write(record);
+			return;
+		}
+
+		dispatcherWakeUp_.set();
+		std::this_thread::yield();
+	}
+
+	// only wake up the dispatcher if it sleeps, setting the event is not free
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	if (dispatcherIdle_)
+		dispatcherWakeUp_.set();
 }
 
-void Burst::Message::wakeUpAllDispatcher()
+void Burst::Message::write(const LogRecord& record)
 {
-	messageQueue_.wakeUpAll();
+	if (record.fileOnly)
+	{
+		// the logfile could have been deactivated in the meantime
+		const auto fileChannel = MinerLogger::getFileFormattingChannel();
+
+		if (fileChannel != nullptr && MinerConfig::getConfig().isLogfileUsed())
+			fileChannel->log(record.message);
+	}
+	else
+		record.logger->log(record.message);
+}
+
+bool Burst::Message::drain()
+{
+	LogRecord record;
+	auto written = false;
+
+	while (ring_.tryPop(record))
+	{
+		try
+		{
+			write(record);
+		}
+		catch (...)
+		{
+			// a broken channel must not stop the dispatcher
+		}
+
+		++written_;
+		written = true;
+	}
+
+	const auto dropped = dropped_.exchange(0);
+
+	if (dropped > 0)
+	{
+		static auto& droppedMessages = Metrics::counter("creepminer_log_dropped_total",
+		                                                "Log messages dropped because the message queue was full");
+		droppedMessages.add(dropped);
+
+		MinerLogger::general->log(create(Poco::Message::PRIO_WARNING, TextType::Error, *MinerLogger::general,
+		                                 Poco::format("%Lu log messages were dropped, the message queue was full", dropped),
+		                                 __FILE__, __LINE__));
+	}
+
+	return written;
 }
 
-Burst::Message::Dispatcher::Dispatcher(Poco::NotificationQueue& queue)
-	: Poco::Task("Message-Dispatcher"), queue_(&queue)
+Burst::Message::Dispatcher::Dispatcher(MessageRing& ring)
+	: Poco::Task("Message-Dispatcher"), ring_(&ring)
 {}
 
 void Burst::Message::Dispatcher::runTask()
 {
 	while (!isCancelled())
 	{
-		// wait for an incoming message...
-		Poco::Notification::Ptr notification(queue_->waitDequeueNotification());
-		MessageNotification::Ptr messageNotification;
-
-		if (notification)
-			// cast to the right notification type
-			messageNotification = notification.cast<MessageNotification>();
-		else
-			// wake up call (a higher instance is forcing us to terminate)
-			return;
+		if (drain())
+			continue;
+
+		// announce the sleep first, so a message queued right now wakes us up again
+		dispatcherIdle_ = true;
 
-		// finally log it
-		messageNotification->logger->log(messageNotification->message);
+		if (!drain())
+			dispatcherWakeUp_.tryWait(100);
+
+		dispatcherIdle_ = false;
 	}
+
+	// write everything that is left
+	drain();
 }
 
 std::unique_ptr<Burst::Message::Dispatcher> Burst::Message::Dispatcher::create()
 {
-	return std::make_unique<Dispatcher>(messageQueue_);
+	return std::make_unique<Dispatcher>(ring_);
 }
 
 Poco::Message Burst::Message::create(Poco::Message::Priority priority, TextType type, Poco::Logger& logger, const std::string& text, const char* file, int line, bool condition)
@@ -122,12 +250,10 @@ Poco::Message Burst::Message::create(Poco::Message::Priority priority, TextType
 
 void Burst::Message::log(Poco::Logger& logger, const Poco::Message& message)
 {
-	logger.log(message);
-
-	// it is possible to make this whole process async by replacing
-	// logger.log(message) with this line of code:
-	//messageQueue_.enqueueNotification(new MessageNotification(logger, message));
-	// then also an instance of the Message::Dispatcher needs to be created in the main
+	LogRecord record;
+	record.logger = &logger;
+	record.message = message;
+	enqueue(record);
 }
 
 void Burst::Message::createAndLog(Poco::Message::Priority priority, TextType type, Poco::Logger& logger, const std::string& text, const char* file, int line, bool condition)
@@ -27,6 +27,12 @@
 #include <Poco/NotificationQueue.h>
 #include <thread>
 #include <Poco/Task.h>
+#include <Poco/Thread.h>
+#include <Poco/Event.h>
+#include <Poco/Mutex.h>
+#include <atomic>
+#include <memory>
+#include "MessageRing.hpp"
 
 namespace Burst
 {
@@ -46,31 +52,14 @@ namespace Burst
 	};
 
 	/**
-	 * \brief A Notification that holds a message to be send.
+	 * \brief What happens to a message if the asynchronous message queue is full.
 	 */
-	struct MessageNotification : Poco::Notification
+	enum class LogOverflowPolicy
 	{
-		/**
-		 * \brief short alias for Poco::AutoPtr<MessageNotification>
-		 */
-		using Ptr = Poco::AutoPtr<MessageNotification>;
-
-		/**
-		 * \brief Constructor.
-		 * \param logger The sending logger.
-		 * \param message The message to send.
-		 */
-		MessageNotification(Poco::Logger& logger, Poco::Message message);
-
-		/**
-		 * \brief The message that was sent.
-		 */
-		Poco::Message message;
-
-		/**
-		 * \brief The sending logger.
-		 */
-		Poco::Logger* logger;
+		// the logging thread waits until there is space
+		Block,
+		// the message is dropped and counted
+		Drop
 	};
 
 	struct Message
@@ -174,21 +163,40 @@ namespace Burst
 		}
 
 		/**
-		 * \brief Wakes up all active dispatcher and forces them to terminate.
+		 * \brief Starts the message dispatcher in its own thread.
+		 * From then on all messages are queued and written by the dispatcher.
+		 */
+		static void startDispatcher();
+
+		/**
+		 * \brief Writes all queued messages and stops the message dispatcher.
+		 * From then on all messages are written by the logging thread.
 		 */
-		static void wakeUpAllDispatcher();
+		static void stopDispatcher();
+
+		/**
+		 * \brief Waits until all messages that were queued before the call are written.
+		 */
+		static void flush();
+
+		/**
+		 * \brief Sets what happens to a message if the message queue is full.
+		 * \param policy The overflow policy.
+		 */
+		static void setOverflowPolicy(LogOverflowPolicy policy);
 
 		/**
 		 * \brief An asyncronous message dispatcher.
-		 * It logs every message, that will be pushed on a queue.
+		 * It is the only consumer of the message ring and writes every message into the channels,
+		 * so the logging threads never wait for the console or the logfile.
 		 */
 		struct Dispatcher : Poco::Task
 		{
 			/**
 			 * \brief Constructor.
-			 * \param queue The queue, from which the message are taken for logging.
+			 * \param ring The ring, from which the messages are taken for logging.
 			 */
-			explicit Dispatcher(Poco::NotificationQueue& queue);
+			explicit Dispatcher(MessageRing& ring);
 
 			/**
 			 * \brief Runs the dispatcher.
@@ -196,14 +204,14 @@ namespace Burst
 			void runTask() override;
 
 			/**
-			 * \brief Creates a new dispatcher that access the global messages queue.
+			 * \brief Creates a new dispatcher that access the global message ring.
 			 * \return A new Dispatcher.
 			 */
 			static std::unique_ptr<Dispatcher> create();
 
 		private:
-			// The message queue, from which the dispatcher takes messages for logging.
-			Poco::NotificationQueue* queue_;
+			// The message ring, from which the dispatcher takes messages for logging.
+			MessageRing* ring_;
 		};
 
 	private:
@@ -253,14 +261,41 @@ namespace Burst
 		static void stackframe(Poco::Message::Priority priority, TextType type,
 		                       Poco::Logger& logger, const Poco::NestedDiagnosticContext& stackframe, const char* file, int line);
 
+		/**
+		 * \brief Queues a record for the dispatcher or writes it directly, if there is no dispatcher.
+		 * \param record The record to log.
+		 */
+		static void enqueue(LogRecord& record);
+
+		/**
+		 * \brief Writes a record into its channels.
+		 * \param record The record to write.
+		 */
+		static void write(const LogRecord& record);
+
+		/**
+		 * \brief Writes all records that are currently in the ring.
+		 * \return true, if at least one record was written, false otherwise.
+		 */
+		static bool drain();
+
 		/**
 		 * \brief Constructor.
 		 * Should not be called.
 		 */
 		Message();
 
-		// queue for all messages to log
-		static Poco::NotificationQueue messageQueue_;
+		// ring for all messages to log
+		static MessageRing ring_;
+		static std::unique_ptr<Dispatcher> dispatcher_;
+		static Poco::Thread dispatcherThread_;
+		static Poco::Event dispatcherWakeUp_;
+		static Poco::FastMutex dispatcherMutex_;
+		static std::atomic<bool> asynchronous_;
+		static std::atomic<bool> dispatcherIdle_;
+		static std::atomic<LogOverflowPolicy> overflowPolicy_;
+		static std::atomic<Poco::UInt64> dropped_;
+		static std::atomic<size_t> written_;
 	};
 }
 
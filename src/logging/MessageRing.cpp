@@ -0,0 +1,93 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "MessageRing.hpp"
+
+Burst::MessageRing::MessageRing(const size_t capacity)
+{
+	size_t size = 2;
+
+	while (size < capacity)
+		size <<= 1;
+
+	cells_ = std::make_unique<Cell[]>(size);
+	mask_ = size - 1;
+
+	for (size_t i = 0; i < size; ++i)
+		cells_[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool Burst::MessageRing::tryPush(LogRecord& record)
+{
+	auto position = pushPosition_.load(std::memory_order_relaxed);
+	Cell* cell;
+
+	for (;;)
+	{
+		cell = &cells_[position & mask_];
+		const auto sequence = cell->sequence.load(std::memory_order_acquire);
+		const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+		// the cell is free, try to reserve it
+		if (diff == 0)
+		{
+			if (pushPosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				break;
+		}
+		// the consumer did not free the cell yet, the ring is full
+		else if (diff < 0)
+			return false;
+		// another producer was faster
+		else
+			position = pushPosition_.load(std::memory_order_relaxed);
+	}
+
+	cell->record = std::move(record);
+	cell->sequence.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+bool Burst::MessageRing::tryPop(LogRecord& record)
+{
+	const auto position = popPosition_.load(std::memory_order_relaxed);
+	auto& cell = cells_[position & mask_];
+	const auto sequence = cell.sequence.load(std::memory_order_acquire);
+
+	// the producer did not finish writing the cell yet
+	if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1) < 0)
+		return false;
+
+	record = std::move(cell.record);
+	cell.record = {};
+	cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+	popPosition_.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+size_t Burst::MessageRing::getPushed() const
+{
+	return pushPosition_.load(std::memory_order_acquire);
+}
+
+size_t Burst::MessageRing::getCapacity() const
+{
+	return mask_ + 1;
+}
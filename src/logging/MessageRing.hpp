@@ -0,0 +1,97 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/Message.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace Poco
+{
+	class Logger;
+}
+
+namespace Burst
+{
+	/**
+	 * \brief A log message that waits in the \class MessageRing to be written.
+	 */
+	struct LogRecord
+	{
+		Poco::Logger* logger = nullptr;
+		Poco::Message message;
+		// the message is only written into the logfile
+		bool fileOnly = false;
+	};
+
+	/**
+	 * \brief A bounded multi-producer single-consumer ring of log records.
+	 * The producers never lock, they only reserve a cell with a compare-and-swap.
+	 * The only consumer is the message dispatcher.
+	 */
+	class MessageRing
+	{
+	public:
+		/**
+		 * \brief Constructor.
+		 * \param capacity The amount of cells, rounded up to the next power of two.
+		 */
+		explicit MessageRing(size_t capacity);
+
+		/**
+		 * \brief Puts a record into the ring.
+		 * Can be called from every thread.
+		 * \param record The record, it is moved into the ring on success.
+		 * \return true, if the record was put into the ring, false if the ring is full.
+		 */
+		bool tryPush(LogRecord& record);
+
+		/**
+		 * \brief Takes the oldest record out of the ring.
+		 * Must only be called by the consumer.
+		 * \param record The taken record.
+		 * \return true, if a record was taken, false if the ring is empty.
+		 */
+		bool tryPop(LogRecord& record);
+
+		/**
+		 * \brief Returns the amount of records that were ever put into the ring.
+		 */
+		size_t getPushed() const;
+
+		size_t getCapacity() const;
+
+	private:
+		struct Cell
+		{
+			std::atomic<size_t> sequence{0};
+			LogRecord record;
+		};
+
+		std::unique_ptr<Cell[]> cells_;
+		size_t mask_;
+		// producers and the consumer work on different cache lines
+		alignas(64) std::atomic<size_t> pushPosition_{0};
+		alignas(64) std::atomic<size_t> popPosition_{0};
+	};
+}
@@ -0,0 +1,238 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "Metrics.hpp"
+#include <Poco/NumberFormatter.h>
+#include <algorithm>
+#include <sstream>
+
+void Burst::MetricCounter::add(const Poco::UInt64 value)
+{
+	cells_[Metrics::getCellIndex()].value.fetch_add(value, std::memory_order_relaxed);
+}
+
+Poco::UInt64 Burst::MetricCounter::get() const
+{
+	Poco::UInt64 sum = 0;
+
+	for (const auto& cell : cells_)
+		sum += cell.value.load(std::memory_order_relaxed);
+
+	return sum;
+}
+
+Burst::MetricHistogram::MetricHistogram(std::vector<Poco::UInt64> bounds, const double scale)
+	: bounds_{std::move(bounds)},
+	  scale_{scale},
+	  cells_{std::make_unique<std::array<Cell, metricCellCount>>()}
+{
+	if (bounds_.size() > maxBuckets)
+		bounds_.resize(maxBuckets);
+
+	std::sort(bounds_.begin(), bounds_.end());
+}
+
+void Burst::MetricHistogram::observe(const Poco::UInt64 value)
+{
+	auto& cell = (*cells_)[Metrics::getCellIndex()];
+	const auto bucket = std::lower_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin();
+
+	cell.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+	cell.sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+Burst::MetricHistogram::Snapshot Burst::MetricHistogram::snapshot() const
+{
+	Snapshot snapshot{std::vector<Poco::UInt64>(bounds_.size() + 1, 0), 0};
+
+	for (const auto& cell : *cells_)
+	{
+		for (size_t i = 0; i < snapshot.buckets.size(); ++i)
+			snapshot.buckets[i] += cell.buckets[i].load(std::memory_order_relaxed);
+
+		snapshot.sum += cell.sum.load(std::memory_order_relaxed);
+	}
+
+	return snapshot;
+}
+
+const std::vector<Poco::UInt64>& Burst::MetricHistogram::getBounds() const
+{
+	return bounds_;
+}
+
+double Burst::MetricHistogram::getScale() const
+{
+	return scale_;
+}
+
+std::vector<Poco::UInt64> Burst::MetricHistogram::exponentialBounds(const Poco::UInt64 start, const Poco::UInt64 factor,
+                                                                    const size_t count)
+{
+	std::vector<Poco::UInt64> bounds;
+	auto bound = start;
+
+	for (size_t i = 0; i < count && i < maxBuckets; ++i, bound *= factor)
+		bounds.emplace_back(bound);
+
+	return bounds;
+}
+
+Burst::Metrics& Burst::Metrics::getInstance()
+{
+	static Metrics metrics;
+	return metrics;
+}
+
+size_t Burst::Metrics::getCellIndex()
+{
+	static std::atomic<size_t> nextIndex{0};
+	thread_local const auto index = nextIndex++ % metricCellCount;
+	return index;
+}
+
+const std::vector<Poco::UInt64>& Burst::Metrics::latencyBounds()
+{
+	static const auto bounds = MetricHistogram::exponentialBounds(100, 4, 10);
+	return bounds;
+}
+
+std::string Burst::Metrics::labelsToString(const MetricLabels& labels)
+{
+	std::string str;
+
+	for (const auto& label : labels)
+	{
+		if (!str.empty())
+			str += ',';
+
+		str += label.first + "=\"";
+
+		for (const auto c : label.second)
+		{
+			if (c == '\\' || c == '"')
+				str += '\\';
+
+			if (c == '\n')
+				str += "\\n";
+			else
+				str += c;
+		}
+
+		str += '"';
+	}
+
+	return str;
+}
+
+Burst::Metrics::Family& Burst::Metrics::getFamily(const std::string& name, const std::string& help, const std::string& type)
+{
+	auto& family = families_[name];
+
+	if (family.type.empty())
+	{
+		family.help = help;
+		family.type = type;
+	}
+
+	return family;
+}
+
+Burst::MetricCounter& Burst::Metrics::counter(const std::string& name, const std::string& help, const MetricLabels& labels)
+{
+	auto& metrics = getInstance();
+	Poco::ScopedLock<Poco::FastMutex> lock{metrics.mutex_};
+
+	auto& counter = metrics.getFamily(name, help, "counter").counters[labelsToString(labels)];
+
+	if (counter == nullptr)
+		counter = std::make_unique<MetricCounter>();
+
+	return *counter;
+}
+
+Burst::MetricHistogram& Burst::Metrics::histogram(const std::string& name, const std::string& help,
+                                                  const MetricLabels& labels, const std::vector<Poco::UInt64>& bounds,
+                                                  const double scale)
+{
+	auto& metrics = getInstance();
+	Poco::ScopedLock<Poco::FastMutex> lock{metrics.mutex_};
+
+	auto& histogram = metrics.getFamily(name, help, "histogram").histograms[labelsToString(labels)];
+
+	if (histogram == nullptr)
+		histogram = std::make_unique<MetricHistogram>(bounds, scale);
+
+	return *histogram;
+}
+
+std::string Burst::Metrics::toPrometheus()
+{
+	auto& metrics = getInstance();
+	Poco::ScopedLock<Poco::FastMutex> lock{metrics.mutex_};
+
+	std::stringstream sstr;
+
+	const auto withLabels = [](const std::string& name, const std::string& labels, const std::string& extra = "")
+	{
+		std::string all = labels;
+
+		if (!extra.empty())
+			all += (all.empty() ? "" : ",") + extra;
+
+		return all.empty() ? name : name + '{' + all + '}';
+	};
+
+	for (const auto& family : metrics.families_)
+	{
+		const auto& name = family.first;
+
+		sstr << "# HELP " << name << ' ' << family.second.help << '\n';
+		sstr << "# TYPE " << name << ' ' << family.second.type << '\n';
+
+		for (const auto& counter : family.second.counters)
+			sstr << withLabels(name, counter.first) << ' ' << counter.second->get() << '\n';
+
+		for (const auto& histogram : family.second.histograms)
+		{
+			const auto& bounds = histogram.second->getBounds();
+			const auto scale = histogram.second->getScale();
+			const auto snapshot = histogram.second->snapshot();
+			Poco::UInt64 cumulative = 0;
+
+			for (size_t i = 0; i < bounds.size(); ++i)
+			{
+				cumulative += snapshot.buckets[i];
+				sstr << withLabels(name + "_bucket", histogram.first,
+				                   "le=\"" + Poco::NumberFormatter::format(bounds[i] * scale) + '"')
+					<< ' ' << cumulative << '\n';
+			}
+
+			cumulative += snapshot.buckets.back();
+
+			sstr << withLabels(name + "_bucket", histogram.first, "le=\"+Inf\"") << ' ' << cumulative << '\n';
+			sstr << withLabels(name + "_sum", histogram.first) << ' ' << Poco::NumberFormatter::format(snapshot.sum * scale) << '\n';
+			sstr << withLabels(name + "_count", histogram.first) << ' ' << cumulative << '\n';
+		}
+	}
+
+	return sstr.str();
+}
@@ -0,0 +1,145 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/Types.h>
+#include <Poco/Mutex.h>
+#include <array>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Burst
+{
+	using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+	/**
+	 * \brief The number of cells every metric is striped into.
+	 * Every thread writes into its own cell, the cells are only summed up when scraped.
+	 */
+	constexpr size_t metricCellCount = 32;
+
+	/**
+	 * \brief A monotonic counter.
+	 */
+	class MetricCounter
+	{
+	public:
+		void add(Poco::UInt64 value = 1);
+		Poco::UInt64 get() const;
+
+	private:
+		struct Cell
+		{
+			std::atomic<Poco::UInt64> value{0};
+			// keep the cells of different threads in different cache lines
+			char padding[64 - sizeof(std::atomic<Poco::UInt64>)];
+		};
+
+		std::array<Cell, metricCellCount> cells_;
+	};
+
+	/**
+	 * \brief A histogram with fixed bucket bounds.
+	 * All observations are integers in a raw unit (ns, us, bytes...),
+	 * that are multiplied by the scale when exported.
+	 */
+	class MetricHistogram
+	{
+	public:
+		static constexpr size_t maxBuckets = 16;
+
+		struct Snapshot
+		{
+			std::vector<Poco::UInt64> buckets;
+			Poco::UInt64 sum;
+		};
+
+		MetricHistogram(std::vector<Poco::UInt64> bounds, double scale);
+
+		void observe(Poco::UInt64 value);
+		Snapshot snapshot() const;
+		const std::vector<Poco::UInt64>& getBounds() const;
+		double getScale() const;
+
+		static std::vector<Poco::UInt64> exponentialBounds(Poco::UInt64 start, Poco::UInt64 factor, size_t count);
+
+	private:
+		struct Cell
+		{
+			std::array<std::atomic<Poco::UInt64>, maxBuckets + 1> buckets{};
+			std::atomic<Poco::UInt64> sum{0};
+			char padding[64];
+		};
+
+		std::vector<Poco::UInt64> bounds_;
+		double scale_;
+		std::unique_ptr<std::array<Cell, metricCellCount>> cells_;
+	};
+
+	/**
+	 * \brief The registry of all metrics, that are exported by the /metrics endpoint.
+	 * Looking up a metric locks the registry, so hot paths should look it up once and keep the reference.
+	 * The returned references stay valid for the whole lifetime of the process.
+	 */
+	class Metrics
+	{
+	public:
+		static MetricCounter& counter(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+		static MetricHistogram& histogram(const std::string& name, const std::string& help, const MetricLabels& labels,
+		                                  const std::vector<Poco::UInt64>& bounds, double scale);
+
+		/**
+		 * \brief Creates the text exposition format of all metrics.
+		 * \return The metrics in the Prometheus text format.
+		 */
+		static std::string toPrometheus();
+
+		/**
+		 * \brief Bucket bounds in microseconds from 100us to ~100s.
+		 */
+		static const std::vector<Poco::UInt64>& latencyBounds();
+
+		/**
+		 * \brief The index of the cell of the calling thread.
+		 */
+		static size_t getCellIndex();
+
+	private:
+		struct Family
+		{
+			std::string help;
+			std::string type;
+			std::map<std::string, std::unique_ptr<MetricCounter>> counters;
+			std::map<std::string, std::unique_ptr<MetricHistogram>> histograms;
+		};
+
+		static Metrics& getInstance();
+		static std::string labelsToString(const MetricLabels& labels);
+		Family& getFamily(const std::string& name, const std::string& help, const std::string& type);
+
+		std::map<std::string, Family> families_;
+		Poco::FastMutex mutex_;
+	};
+}
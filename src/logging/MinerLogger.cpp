@@ -307,6 +307,9 @@ std::string Burst::MinerLogger::setLogDir(const std::string& dir)
 
 void Burst::MinerLogger::setChannelMinerData(MinerData* minerData)
 {
+	// the queued messages still belong to the old miner data
+	Message::flush();
+
 	for (auto& channel : websocketChannels)
 		channel.second->setMinerData(minerData);
 }
@@ -451,6 +454,9 @@ void Burst::MinerLogger::setup()
 	}
 
 	refreshChannels();
+
+	// log asynchronously until the configuration says otherwise
+	Message::startDispatcher();
 }
 
 void Burst::MinerLogger::refreshChannels()
@@ -0,0 +1,256 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "Tracing.hpp"
+#include "MinerLogger.hpp"
+#include <Poco/Mutex.h>
+#include <Poco/Thread.h>
+#include <Poco/FileStream.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Array.h>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace Burst
+{
+	namespace TracingHelper
+	{
+		struct Event
+		{
+			const char* name;
+			const char* category;
+			Poco::UInt64 begin;
+			Poco::UInt64 duration;
+			Poco::UInt64 block;
+		};
+
+		struct ThreadBuffer
+		{
+			static constexpr size_t capacity = 1 << 16;
+
+			explicit ThreadBuffer(const Poco::UInt64 tid, std::string name)
+				: tid{tid}, name{std::move(name)}
+			{
+				events.reserve(capacity);
+			}
+
+			void add(const Event& event)
+			{
+				Poco::ScopedLock<Poco::FastMutex> lock{mutex};
+
+				// overwrite the oldest events, when the buffer is full
+				if (events.size() < capacity)
+					events.emplace_back(event);
+				else
+					events[next] = event;
+
+				next = (next + 1) % capacity;
+			}
+
+			Poco::UInt64 tid;
+			std::string name;
+			std::vector<Event> events;
+			size_t next = 0;
+			Poco::FastMutex mutex;
+		};
+
+		struct State
+		{
+			Poco::UInt64 fromBlock = 0;
+			Poco::UInt64 toBlock = 0;
+			std::string path;
+			bool configured = false;
+			std::atomic<Poco::UInt64> block{0};
+			std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+			Poco::FastMutex mutex;
+		};
+
+		State& getState()
+		{
+			static State state;
+			return state;
+		}
+
+		ThreadBuffer& getThreadBuffer()
+		{
+			// the buffers are owned by the state, so they survive the end of their threads
+			thread_local std::shared_ptr<ThreadBuffer> buffer;
+
+			if (buffer == nullptr)
+			{
+				auto& state = getState();
+				const auto thread = Poco::Thread::current();
+				Poco::ScopedLock<Poco::FastMutex> lock{state.mutex};
+
+				buffer = std::make_shared<ThreadBuffer>(state.buffers.size() + 1,
+				                                        thread == nullptr ? "main" : thread->getName());
+				state.buffers.emplace_back(buffer);
+			}
+
+			return *buffer;
+		}
+	}
+}
+
+std::atomic<bool> Burst::Tracing::active_{false};
+
+void Burst::Tracing::setup(const Poco::UInt64 fromBlock, const Poco::UInt64 toBlock, const std::string& path)
+{
+	auto& state = TracingHelper::getState();
+	Poco::ScopedLock<Poco::FastMutex> lock{state.mutex};
+
+	state.fromBlock = fromBlock;
+	state.toBlock = toBlock < fromBlock ? fromBlock : toBlock;
+	state.path = path;
+	state.configured = true;
+}
+
+void Burst::Tracing::setBlock(const Poco::UInt64 blockheight)
+{
+	auto& state = TracingHelper::getState();
+	bool startTrace, dumpTrace;
+
+	{
+		Poco::ScopedLock<Poco::FastMutex> lock{state.mutex};
+
+		if (!state.configured)
+			return;
+
+		state.block = blockheight;
+
+		const auto inRange = blockheight >= state.fromBlock && blockheight <= state.toBlock;
+		startTrace = !isActive() && inRange;
+		dumpTrace = isActive() && !inRange;
+		active_ = inRange;
+
+		if (dumpTrace)
+			state.configured = false;
+	}
+
+	if (startTrace)
+		log_system(MinerLogger::general, "Started tracing at block %Lu", blockheight);
+
+	if (dumpTrace)
+		dump();
+}
+
+Poco::UInt64 Burst::Tracing::now()
+{
+	static const auto start = std::chrono::steady_clock::now();
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Burst::Tracing::record(const char* name, const char* category, const Poco::UInt64 begin, const Poco::UInt64 end)
+{
+	TracingHelper::getThreadBuffer().add({name, category, begin, end - begin, TracingHelper::getState().block.load()});
+}
+
+bool Burst::Tracing::dump()
+{
+	poco_ndc(Tracing::dump);
+
+	auto& state = TracingHelper::getState();
+	std::vector<std::shared_ptr<TracingHelper::ThreadBuffer>> buffers;
+	std::string path;
+
+	{
+		Poco::ScopedLock<Poco::FastMutex> lock{state.mutex};
+		buffers = state.buffers;
+		path = state.path;
+	}
+
+	try
+	{
+		Poco::JSON::Array events;
+
+		for (const auto& buffer : buffers)
+		{
+			Poco::ScopedLock<Poco::FastMutex> lock{buffer->mutex};
+
+			Poco::JSON::Object threadName;
+			Poco::JSON::Object threadNameArgs;
+			threadNameArgs.set("name", buffer->name);
+			threadName.set("name", "thread_name");
+			threadName.set("ph", "M");
+			threadName.set("pid", 1);
+			threadName.set("tid", buffer->tid);
+			threadName.set("args", threadNameArgs);
+			events.add(threadName);
+
+			for (const auto& event : buffer->events)
+			{
+				Poco::JSON::Object json;
+				Poco::JSON::Object args;
+				args.set("block", event.block);
+				json.set("name", event.name);
+				json.set("cat", event.category);
+				json.set("ph", "X");
+				json.set("ts", event.begin);
+				json.set("dur", event.duration);
+				json.set("pid", 1);
+				json.set("tid", buffer->tid);
+				json.set("args", args);
+				events.add(json);
+			}
+
+			buffer->events.clear();
+			buffer->next = 0;
+		}
+
+		Poco::JSON::Object trace;
+		trace.set("traceEvents", events);
+		trace.set("displayTimeUnit", "ms");
+
+		Poco::FileOutputStream stream{path};
+		trace.stringify(stream);
+
+		log_system(MinerLogger::general, "Wrote the trace of %z threads to '%s'", buffers.size(), path);
+		return true;
+	}
+	catch (const Poco::Exception& e)
+	{
+		log_error(MinerLogger::general, "Could not write the trace to '%s': %s", path, e.displayText());
+		log_current_stackframe(MinerLogger::general);
+		return false;
+	}
+}
+
+Burst::TraceSpan::TraceSpan(const char* name, const char* category)
+	: name_{name}, category_{category}, begin_{0}, active_{Tracing::isActive()}
+{
+	if (active_)
+		begin_ = Tracing::now();
+}
+
+Burst::TraceSpan::~TraceSpan()
+{
+	end();
+}
+
+void Burst::TraceSpan::end()
+{
+	if (!active_)
+		return;
+
+	Tracing::record(name_, category_, begin_, Tracing::now());
+	active_ = false;
+}
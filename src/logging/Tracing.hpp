@@ -0,0 +1,92 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/Types.h>
+#include <atomic>
+#include <string>
+
+namespace Burst
+{
+	/**
+	 * \brief Records begin/end spans of the worker threads and dumps them as Chrome trace JSON.
+	 * Tracing is only active for a chosen block range, every thread writes into its own ring buffer.
+	 * When tracing is inactive, a span costs a single relaxed atomic load.
+	 */
+	class Tracing
+	{
+	public:
+		/**
+		 * \brief Enables tracing for a block range.
+		 * \param fromBlock The first traced block.
+		 * \param toBlock The last traced block.
+		 * \param path The path of the trace file, that is written after the last traced block.
+		 */
+		static void setup(Poco::UInt64 fromBlock, Poco::UInt64 toBlock, const std::string& path);
+
+		/**
+		 * \brief Notifies the tracer about a new block.
+		 * Starts tracing when the block range is entered and dumps the trace when it is left.
+		 * \param blockheight The height of the new block.
+		 */
+		static void setBlock(Poco::UInt64 blockheight);
+
+		static bool isActive()
+		{
+			return active_.load(std::memory_order_relaxed);
+		}
+
+		static Poco::UInt64 now();
+		static void record(const char* name, const char* category, Poco::UInt64 begin, Poco::UInt64 end);
+
+		/**
+		 * \brief Writes all recorded spans into the trace file.
+		 * \return true, if the file was written.
+		 */
+		static bool dump();
+
+	private:
+		static std::atomic<bool> active_;
+	};
+
+	/**
+	 * \brief A span, that is recorded when it ends (or goes out of scope).
+	 * The names and categories need to be string literals.
+	 */
+	class TraceSpan
+	{
+	public:
+		TraceSpan(const char* name, const char* category);
+		~TraceSpan();
+
+		TraceSpan(const TraceSpan&) = delete;
+		TraceSpan& operator=(const TraceSpan&) = delete;
+
+		void end();
+
+	private:
+		const char* name_;
+		const char* category_;
+		Poco::UInt64 begin_;
+		bool active_;
+	};
+}
@@ -46,6 +46,12 @@
 #include <regex>
 #include <Poco/Data/SQLite/Connector.h>
 #include "MinerUtil.hpp"
+#include "logging/Tracing.hpp"
+#include <Poco/NumberParser.h>
+#include <Poco/NumberFormatter.h>
+#include <Poco/Timestamp.h>
+#include <future>
+#include <iostream>
 
 class SslInitializer
 {
@@ -69,10 +75,15 @@ struct Arguments
 
 	bool helpRequested = false;
 	std::string confPath = "mining.conf";
+	bool trace = false;
+	Poco::UInt64 traceFrom = 0, traceTo = 0;
+	std::string tracePath;
 
 private:
 	void displayHelp(const std::string& name, const std::string& value);
 	void setConfPath(const std::string& name, const std::string& value);
+	void setTrace(const std::string& name, const std::string& value);
+	void setTracePath(const std::string& name, const std::string& value);
 
 private:
 	Poco::Util::OptionSet options_;
@@ -92,10 +103,10 @@ int main(const int argc, const char* argv[])
 
 	Burst::MinerLogger::setup();
 
-	// create a message dispatcher..
-	//auto messageDispatcher = Burst::Message::Dispatcher::create();
-	// ..and start it in its own thread
-	//Poco::ThreadPool::defaultPool().start(*messageDispatcher);
+	if (arguments.trace)
+		Burst::Tracing::setup(arguments.traceFrom, arguments.traceTo, arguments.tracePath.empty()
+			? Poco::format("trace-%Lu-%Lu.json", arguments.traceFrom, arguments.traceTo)
+			: arguments.tracePath);
 
 	const auto general = &Poco::Logger::get("general");
 
@@ -140,6 +151,16 @@ int main(const int argc, const char* argv[])
 
 		while (running)
 		{
+			// the startup phases are timed, to keep track of the boot time
+			Timestamp startupTime, phaseTime;
+
+			const auto logPhase = [&](const std::string& phase, Timestamp& start)
+			{
+				log_system(general, "Startup: %s took %ss", phase,
+				           NumberFormatter::format(static_cast<double>(start.elapsed()) / 1000000, 3));
+				start.update();
+			};
+
 			// load the config
 			auto& config = Burst::MinerConfig::getConfig();
 			auto configLoaded = config.readConfigFile(arguments.confPath);
@@ -203,6 +224,7 @@ int main(const int argc, const char* argv[])
 			if (configLoaded == Burst::ReadConfigFileResult::Ok)
 			{
 				log_information(general, "Config loaded: %s", Burst::MinerConfig::getConfig().getPath());
+				logPhase("loading the config and scanning the plot files", phaseTime);
 
 				if (!config.getServerCertificatePath().empty())
 				{
@@ -237,19 +259,41 @@ int main(const int argc, const char* argv[])
 				Burst::Miner miner;
 				Burst::MinerServer server{miner};
 
-				if (config.getStartServer())
-				{
-					server.connectToMinerData(miner.getData());
-					server.run(config.getServerUrl().getPort());
-				}
+				logPhase("creating the miner", phaseTime);
 
 				Burst::MinerLogger::setChannelMinerData(&miner.getData());
-				config.checkPlotOverlaps();
+
+				// the web UI and the overlap check are not needed for mining, so they are finished in the background
+				auto backgroundStartup = std::async(std::launch::async, [&]()
+				{
+					Timestamp backgroundTime;
+
+					try
+					{
+						if (config.getStartServer())
+						{
+							server.connectToMinerData(miner.getData());
+							server.run(config.getServerUrl().getPort());
+							logPhase("starting the webserver", backgroundTime);
+						}
+
+						config.checkPlotOverlaps();
+						logPhase("checking the plot files for overlaps", backgroundTime);
+					}
+					catch (const Exception& exc)
+					{
+						log_error(general, "Background startup failed: %s", exc.displayText());
+						log_current_stackframe(general);
+					}
+				});
 
 				if (!config.getProxyFullUrl().empty())
 					HTTPClientSession::setGlobalProxyConfig(config.getProxyConfig());
 
-				miner.run();
+				log_system(general, "Startup: the startup until mining took %ss",
+				           NumberFormatter::format(static_cast<double>(startupTime.elapsed()) / 1000000, 3));
+				miner.run(startupTime);
+				backgroundStartup.wait();
 				server.stop();
 
 				running = miner.wantRestart();
@@ -275,8 +319,8 @@ int main(const int argc, const char* argv[])
 		log_fatal(general, "Aborting program due to exceptional state: %s", std::string(exc.what()));
 	}
 
-	// wake up all message dispatcher
-	//Burst::Message::wakeUpAllDispatcher();
+	// write all queued messages
+	Burst::Message::stopDispatcher();
 
 	// stop all running background-tasks
 	Poco::ThreadPool::defaultPool().stopAll();
@@ -312,6 +356,20 @@ Arguments::Arguments()
 		.repeatable(false)
 		.argument("path")
 		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setConfPath)));
+
+	options_.addOption(Option("trace", "t", "Records the reader, verifier and submitter threads\n"
+		"for a block range and writes them as Chrome trace JSON\n"
+		"e.g. --trace=500000-500002 or --trace=500000")
+		.required(false)
+		.repeatable(false)
+		.argument("blocks")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setTrace)));
+
+	options_.addOption(Option("trace-file", "", "Path of the trace file (default: trace-<from>-<to>.json)")
+		.required(false)
+		.repeatable(false)
+		.argument("path")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setTracePath)));
 }
 
 bool Arguments::process(const int argc, const char* argv[])
@@ -370,6 +428,20 @@ void Arguments::setConfPath(const std::string& name, const std::string& value)
 	confPath = value;
 }
 
+void Arguments::setTrace(const std::string& name, const std::string& value)
+{
+	const auto separator = value.find('-');
+
+	traceFrom = Poco::NumberParser::parseUnsigned64(value.substr(0, separator));
+	traceTo = separator == std::string::npos ? traceFrom : Poco::NumberParser::parseUnsigned64(value.substr(separator + 1));
+	trace = true;
+}
+
+void Arguments::setTracePath(const std::string& name, const std::string& value)
+{
+	tracePath = value;
+}
+
 KeyConfigHandler::KeyConfigHandler(bool server)
 	: PrivateKeyPassphraseHandler{server}
 {}
@@ -0,0 +1,257 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "DatabaseWriter.hpp"
+#include "MinerData.hpp"
+#include "MinerUtil.hpp"
+#include "logging/MinerLogger.hpp"
+#include "MinerConfig.hpp"
+#include <Poco/Format.h>
+#include <algorithm>
+
+using namespace Poco::Data::Keywords;
+
+Burst::DatabaseWriter::WriteNotification::WriteNotification(std::shared_ptr<const BlockData> block)
+	: block{std::move(block)}
+{}
+
+Burst::DatabaseWriter::DatabaseWriter(const std::string& databasePath)
+	: session_{"SQLite", databasePath}
+{
+	std::string journalMode;
+	session_ << "PRAGMA journal_mode=WAL", into(journalMode), now;
+	session_ << "PRAGMA synchronous=NORMAL", now;
+
+	insertBlock_ = std::make_unique<Poco::Data::Statement>((session_ <<
+		"INSERT INTO block VALUES (NULL, ?, ?, ?, ?, ?, ?, ?, ?)",
+		use(block_.height), use(block_.scoop), use(block_.baseTarget), use(block_.gensig), use(block_.difficulty),
+		use(block_.targetDeadline), use(block_.roundTime), use(block_.blockTime)));
+
+	insertDeadline_ = std::make_unique<Poco::Data::Statement>((session_ <<
+		"INSERT INTO deadline VALUES (NULL, ?, ?, ?, ?, ?, ?, ?, ?)",
+		use(block_.height), use(deadline_.account), use(deadline_.nonce), use(deadline_.value), use(deadline_.file),
+		use(deadline_.miner), use(deadline_.totalPlotsize), use(deadline_.status)));
+
+	insertTimeline_ = std::make_unique<Poco::Data::Statement>((session_ <<
+		"INSERT INTO timeline VALUES (NULL, ?, ?)",
+		use(block_.height), use(timeline_)));
+
+	insertThroughput_ = std::make_unique<Poco::Data::Statement>((session_ <<
+		"INSERT INTO read_throughput VALUES (NULL, ?, ?, ?, ?, ?)",
+		use(block_.height), use(throughput_.device), use(throughput_.file), use(throughput_.bytes),
+		use(throughput_.duration)));
+
+	thread_.setName("DatabaseWriter");
+	thread_.start(*this);
+}
+
+Burst::DatabaseWriter::~DatabaseWriter()
+{
+	// the stop notification is queued behind all pending blocks, so they are still written
+	queue_.enqueueNotification(new WriteNotification{nullptr});
+	thread_.join();
+}
+
+void Burst::DatabaseWriter::write(std::shared_ptr<const BlockData> block)
+{
+	if (block == nullptr)
+		return;
+
+	{
+		Poco::FastMutex::ScopedLock lock{pendingMutex_};
+		pending_.emplace_back(block);
+	}
+
+	queue_.enqueueNotification(new WriteNotification{std::move(block)});
+}
+
+std::vector<std::shared_ptr<const Burst::BlockData>> Burst::DatabaseWriter::getPending() const
+{
+	Poco::FastMutex::ScopedLock lock{pendingMutex_};
+	return pending_;
+}
+
+void Burst::DatabaseWriter::run()
+{
+	while (true)
+	{
+		Poco::AutoPtr<WriteNotification> notification{dynamic_cast<WriteNotification*>(queue_.waitDequeueNotification())};
+
+		if (notification.isNull() || notification->block == nullptr)
+			break;
+
+		writeBlock(*notification->block);
+
+		// the block is committed (or dropped after an error), readers find it in the database from now on
+		{
+			Poco::FastMutex::ScopedLock lock{pendingMutex_};
+			pending_.erase(std::remove(pending_.begin(), pending_.end(), notification->block), pending_.end());
+		}
+
+		compact(notification->block->getBlockheight());
+	}
+}
+
+void Burst::DatabaseWriter::writeBlock(const BlockData& block)
+{
+	poco_ndc(DatabaseWriter::writeBlock);
+
+	try
+	{
+		block_.height = block.getBlockheight();
+		block_.scoop = block.getScoop();
+		block_.baseTarget = block.getBasetarget();
+		block_.gensig = block.getGensigStr();
+		block_.difficulty = block.getDifficulty();
+		block_.targetDeadline = block.getBlockTargetDeadline();
+		block_.roundTime = block.getRoundTime();
+		block_.blockTime = block.getBlockTime();
+		timeline_ = jsonToString(block.getTimeline().toJSON(block_.height));
+
+		session_.begin();
+
+		insertBlock_->execute();
+		insertTimeline_->execute();
+
+		block.forDeadlines([this](const Deadline& deadline)
+		{
+			deadline_.status = [&]()
+			{
+				if (deadline.isConfirmed())
+					return 3;
+
+				if (deadline.isSent())
+					return 2;
+
+				if (deadline.isOnTheWay())
+					return 1;
+
+				return 0;
+			}();
+
+			deadline_.account = deadline.getAccountId();
+			deadline_.nonce = deadline.getNonce();
+			deadline_.value = deadline.getDeadline();
+			deadline_.file = deadline.getPlotFile();
+			deadline_.miner = deadline.getMiner();
+			deadline_.totalPlotsize = static_cast<double>(deadline.getTotalPlotsize());
+
+			insertDeadline_->execute();
+			return false;
+		});
+
+		// the rows per plot file stay raw only within the retention, the compaction keeps the totals of the devices
+		for (const auto& throughput : block.getReadThroughputs())
+		{
+			throughput_.device = throughput.device;
+			throughput_.file = throughput.file;
+			throughput_.bytes = throughput.bytes;
+			throughput_.duration = throughput.duration;
+			insertThroughput_->execute();
+		}
+
+		session_.commit();
+	}
+	catch (const Poco::Exception& e)
+	{
+		if (session_.isTransaction())
+			session_.rollback();
+
+		log_error(MinerLogger::general, "Could not insert block %Lu\n\tReason: %s", block_.height, e.displayText());
+		log_current_stackframe(MinerLogger::general);
+	}
+}
+
+void Burst::DatabaseWriter::compact(const Poco::UInt64 height)
+{
+	poco_ndc(DatabaseWriter::compact);
+
+	const auto retentionDays = MinerConfig::getConfig().getHistoryRetentionDays();
+
+	if (retentionDays == 0)
+		return;
+
+	// the historical blocks shown in the web UI always stay raw
+	const auto retention = std::max<Poco::UInt64>(retentionDays * blocksPerDay,
+		MinerConfig::getConfig().getMaxHistoricalBlocks());
+
+	if (height < retention)
+		return;
+
+	// only whole days are compacted, so every day is summarized exactly once
+	const auto cutoff = (height - retention) / blocksPerDay * blocksPerDay;
+
+	if (cutoff <= compactedHeight_)
+		return;
+
+	try
+	{
+		Poco::UInt64 blocks = 0;
+		session_ << "SELECT COUNT(*) FROM block WHERE height < ?", into(blocks), bind(cutoff), now;
+
+		if (blocks > 0)
+		{
+			const auto day = Poco::format("height / %Lu", blocksPerDay);
+			const auto older = Poco::format("height < %Lu", cutoff);
+
+			session_.begin();
+
+			session_ <<
+				"INSERT OR REPLACE INTO daily_summary " <<
+				"SELECT b.day, b.fromHeight, b.toHeight, b.blocks, lo.difficulty, lo.height, hi.difficulty, hi.height, " <<
+				"	b.roundTimeSum, b.blockTimeSum, IFNULL(d.confirmed, 0), IFNULL(d.deadlineSum, 0), " <<
+				"	best.nonce, best.value, best.account, best.height, best.file " <<
+				"FROM (SELECT " << day << " AS day, MIN(height) AS fromHeight, MAX(height) AS toHeight, COUNT(*) AS blocks, " <<
+				"		SUM(roundTime) AS roundTimeSum, SUM(blockTime) AS blockTimeSum " <<
+				"		FROM block WHERE " << older << " GROUP BY day) b " <<
+				"JOIN (SELECT " << day << " AS day, height, MIN(difficulty) AS difficulty " <<
+				"		FROM block WHERE " << older << " GROUP BY day) lo ON lo.day = b.day " <<
+				"JOIN (SELECT " << day << " AS day, height, MAX(difficulty) AS difficulty " <<
+				"		FROM block WHERE " << older << " GROUP BY day) hi ON hi.day = b.day " <<
+				"LEFT JOIN (SELECT " << day << " AS day, COUNT(*) AS confirmed, SUM(value) AS deadlineSum " <<
+				"		FROM deadline WHERE status = 3 AND " << older << " GROUP BY day) d ON d.day = b.day " <<
+				"LEFT JOIN (SELECT " << day << " AS day, nonce, MIN(value) AS value, account, height, file " <<
+				"		FROM deadline WHERE status = 3 AND " << older << " GROUP BY day) best ON best.day = b.day", now;
+
+			session_ <<
+				"INSERT OR REPLACE INTO daily_read_throughput " <<
+				"SELECT " << day << " AS day, device, COUNT(*), SUM(bytes), SUM(duration) " <<
+				"FROM read_throughput WHERE file = '' AND " << older << " GROUP BY day, device", now;
+
+			for (const auto& table : {"deadline", "block", "timeline", "read_throughput"})
+				session_ << "DELETE FROM " << table << " WHERE " << older, now;
+
+			session_.commit();
+
+			log_information(MinerLogger::general, "Compacted %Lu blocks below height %Lu into daily summaries", blocks, cutoff);
+		}
+
+		compactedHeight_ = cutoff;
+	}
+	catch (const Poco::Exception& e)
+	{
+		if (session_.isTransaction())
+			session_.rollback();
+
+		log_error(MinerLogger::general, "Could not compact the history below height %Lu\n\tReason: %s", cutoff, e.displayText());
+		log_current_stackframe(MinerLogger::general);
+	}
+}
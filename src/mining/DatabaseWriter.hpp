@@ -0,0 +1,124 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/Runnable.h>
+#include <Poco/Thread.h>
+#include <Poco/NotificationQueue.h>
+#include <Poco/Data/Session.h>
+#include <Poco/Data/Statement.h>
+#include <Poco/Mutex.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Burst
+{
+	class BlockData;
+
+	/**
+	 * \brief Writes finished blocks into the database in its own thread.
+	 * Every block is written in one transaction with prepared statements, that are reused for all blocks.
+	 * The writer has its own session and switches the database into WAL mode,
+	 * so readers are not blocked while a block is written.
+	 * Rounds older than the configured retention are compacted into daily summaries
+	 * by the same thread, after a block was written.
+	 */
+	class DatabaseWriter : public Poco::Runnable
+	{
+	public:
+		explicit DatabaseWriter(const std::string& databasePath);
+		~DatabaseWriter() override;
+
+		/**
+		 * \brief Queues a finished block for writing.
+		 * \param block The block.
+		 */
+		void write(std::shared_ptr<const BlockData> block);
+
+		/**
+		 * \brief Returns all blocks, that are queued but not yet committed.
+		 * Readers merge them into their results, so a finished round is visible before it is written.
+		 * \return The pending blocks in the order they were queued.
+		 */
+		std::vector<std::shared_ptr<const BlockData>> getPending() const;
+
+		void run() override;
+
+		/**
+		 * \brief The number of blocks, that are summarized into one day.
+		 * A burst block takes 4 minutes on average, so the days are counted by the height.
+		 */
+		static constexpr Poco::UInt64 blocksPerDay = 360;
+
+	private:
+		struct WriteNotification : Poco::Notification
+		{
+			explicit WriteNotification(std::shared_ptr<const BlockData> block);
+			// a notification without a block stops the writer
+			std::shared_ptr<const BlockData> block;
+		};
+
+		void writeBlock(const BlockData& block);
+
+		/**
+		 * \brief Moves all days, that are older than the retention, into the daily summaries
+		 * and deletes their raw rows.
+		 * \param height The height of the last written block.
+		 */
+		void compact(Poco::UInt64 height);
+
+		Poco::Data::Session session_;
+		Poco::NotificationQueue queue_;
+		Poco::Thread thread_;
+		std::vector<std::shared_ptr<const BlockData>> pending_;
+		mutable Poco::FastMutex pendingMutex_;
+
+		// the values bound to the prepared statements
+		struct
+		{
+			Poco::UInt64 height = 0, scoop = 0, baseTarget = 0, difficulty = 0, targetDeadline = 0, blockTime = 0;
+			double roundTime = 0;
+			std::string gensig;
+		} block_;
+
+		struct
+		{
+			Poco::UInt64 account = 0, nonce = 0, value = 0;
+			std::string file, miner;
+			double totalPlotsize = 0;
+			int status = 0;
+		} deadline_;
+
+		struct
+		{
+			std::string device, file;
+			Poco::UInt64 bytes = 0, duration = 0;
+		} throughput_;
+
+		std::string timeline_;
+		// every raw row below this height is already compacted
+		Poco::UInt64 compactedHeight_ = 0;
+
+		std::unique_ptr<Poco::Data::Statement> insertBlock_, insertDeadline_, insertTimeline_, insertThroughput_;
+	};
+}
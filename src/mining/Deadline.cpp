@@ -145,7 +145,7 @@ const Poco::Net::IPAddress& Burst::Deadline::getIp() const
 
 std::string Burst::Deadline::toActionString(const std::string& action) const
 {
-	if (MinerConfig::getConfig().isVerboseLogging())
+	if (MinerConfig::getConfig().getSnapshot()->verboseLogging)
 		return Poco::format("%s: %s (%s)\n"
 		                    "\tnonce: %s\n"
 		                    "\tin:    %s\n"
@@ -34,17 +34,58 @@
 #include <Poco/File.h>
 #include <Poco/Delegate.h>
 #include "plots/PlotVerifier.hpp"
+#include "network/JsonFieldExtractor.hpp"
+#include "logging/Metrics.hpp"
+#include "logging/Tracing.hpp"
+#include "Numa.hpp"
+#include <algorithm>
 
 namespace Burst
 {
 	namespace MinerHelper
 	{
-		template <typename T>
-		void createWorkerDefault(std::unique_ptr<Poco::ThreadPool>& thread_pool, std::unique_ptr<Poco::TaskManager>& task_manager,
-			const size_t size, Miner& miner, Poco::NotificationQueue& queue)
+		void createPool(std::unique_ptr<Poco::ThreadPool>& thread_pool, std::unique_ptr<Poco::TaskManager>& task_manager,
+			const size_t size)
 		{
 			thread_pool = std::make_unique<Poco::ThreadPool>(1, static_cast<int>(size));
 			task_manager = std::make_unique<Poco::TaskManager>(*thread_pool);
+		}
+
+		void growPool(Poco::ThreadPool& thread_pool, const size_t size)
+		{
+			// retired workers give their thread back to the pool, so we only grow if there are not enough idle threads
+			if (thread_pool.available() < static_cast<int>(size))
+				thread_pool.addCapacity(static_cast<int>(size) - thread_pool.available());
+		}
+
+		// empties a queue, the wake ups of idle workers are queued again, so no retirement is lost
+		void drainQueue(Poco::NotificationQueue& queue, const std::function<void(Poco::Notification&)>& drop)
+		{
+			unsigned wakeUps = 0;
+
+			for (Poco::Notification::Ptr notification(queue.dequeueNotification()); !notification.isNull();
+			     notification = queue.dequeueNotification())
+			{
+				if (dynamic_cast<WorkerNotification*>(notification.get()) != nullptr)
+					++wakeUps;
+				else
+					drop(*notification);
+			}
+
+			WorkerNotification::post(wakeUps, queue);
+		}
+
+		// the verifiers are shared between the nodes like the buffers, the remainder goes to the first nodes
+		unsigned getVerifierShare(const unsigned count, const size_t node, const size_t nodes)
+		{
+			return static_cast<unsigned>(count / nodes + (node < count % nodes ? 1 : 0));
+		}
+
+		template <typename T>
+		void startWorkerDefault(Poco::ThreadPool& thread_pool, Poco::TaskManager& task_manager,
+			const size_t size, Miner& miner, Poco::NotificationQueue& queue, WorkerRetirement& retirement, const size_t node)
+		{
+			growPool(thread_pool, size);
 
 			auto submitFunction = [&miner](Poco::UInt64 nonce, Poco::UInt64 accountId, Poco::UInt64 deadline,
 			                               Poco::UInt64 blockheight, const std::string& plotFile,
@@ -66,36 +107,152 @@ namespace Burst
 			};
 
 			for (size_t i = 0; i < size; ++i)
-				task_manager->start(new T(miner.getData(), queue, submitFunction));
+				task_manager.start(new T(miner.getData(), queue, submitFunction, retirement, node));
 		}
 
 		template <typename T, typename ...Args>
-		void createWorker(std::unique_ptr<Poco::ThreadPool>& thread_pool, std::unique_ptr<Poco::TaskManager>& task_manager,
+		void startWorker(Poco::ThreadPool& thread_pool, Poco::TaskManager& task_manager,
 			const size_t size, Args&&... args)
 		{
-			thread_pool = std::make_unique<Poco::ThreadPool>(1, static_cast<int>(size));
-			task_manager = std::make_unique<Poco::TaskManager>(*thread_pool);
+			growPool(thread_pool, size);
 
 			for (size_t i = 0; i < size; ++i)
-				task_manager->start(new T(std::forward<Args>(args)...));
+				task_manager.start(new T(std::forward<Args>(args)...));
+		}
+
+		// the settings that decide which parts of the miner have to be rebuilt on a restart
+		struct RestartSettings
+		{
+			std::string serverUrl, serverCertificate, databasePath, processorType, cpuInstructionSet, miningInfoUrl, walletUrl;
+			bool startServer = false;
+			unsigned gpuPlatform = 0, gpuDevice = 0, wakeUpTime = 0;
+			// the target deadline, the mining info is served with
+			Poco::UInt64 targetDeadline = 0;
+
+			static RestartSettings fromConfig(const MinerConfig& config)
+			{
+				RestartSettings settings;
+				settings.serverUrl = config.getServerUrl().getCanonical(true);
+				settings.serverCertificate = config.getServerCertificatePath();
+				settings.databasePath = config.getDatabasePath();
+				settings.processorType = config.getProcessorType();
+				settings.cpuInstructionSet = config.getCpuInstructionSet();
+				settings.miningInfoUrl = config.getMiningInfoUrl().getCanonical(true);
+				settings.walletUrl = config.getWalletUrl().getCanonical(true);
+				settings.startServer = config.getStartServer();
+				settings.gpuPlatform = config.getGpuPlatform();
+				settings.gpuDevice = config.getGpuDevice();
+				settings.wakeUpTime = config.getWakeUpTime();
+				settings.targetDeadline = config.getSnapshot()->getTargetDeadline();
+				return settings;
+			}
+
+			bool needsFullRestart(const RestartSettings& other) const
+			{
+				// the webserver, the database and the GPU are set up outside of the miner
+				const auto usesGpu = processorType != "CPU" || other.processorType != "CPU";
+
+				return serverUrl != other.serverUrl ||
+					serverCertificate != other.serverCertificate ||
+					startServer != other.startServer ||
+					databasePath != other.databasePath ||
+					(usesGpu && (processorType != other.processorType ||
+						gpuPlatform != other.gpuPlatform ||
+						gpuDevice != other.gpuDevice));
+			}
+
+			bool needsNewVerifiers(const RestartSettings& other) const
+			{
+				return processorType != other.processorType || cpuInstructionSet != other.cpuInstructionSet;
+			}
+		};
+
+		struct MiningInfo
+		{
+			std::string gensig;
+			Poco::UInt64 height = 0, baseTarget = 0, targetDeadline = 0;
+			bool hasBlock = false, hasTargetDeadline = false;
+		};
+
+		bool parseMiningInfo(const std::string& data, MiningInfo& miningInfo)
+		{
+			// fast path for the fixed schema of the mining info
+			const JsonFieldExtractor extractor{data};
+
+			if (extractor.isValid() &&
+				extractor.getString("generationSignature", miningInfo.gensig) &&
+				extractor.getUnsigned("height", miningInfo.height) &&
+				extractor.getUnsigned("baseTarget", miningInfo.baseTarget))
+			{
+				miningInfo.hasBlock = true;
+				miningInfo.hasTargetDeadline = extractor.has("targetDeadline");
+
+				if (!miningInfo.hasTargetDeadline || extractor.isNull("targetDeadline") ||
+					extractor.getUnsigned("targetDeadline", miningInfo.targetDeadline))
+					return true;
+			}
+
+			// the response looks different than expected, so we let the full parser handle it
+			miningInfo = {};
+
+			HttpResponse httpResponse(data);
+			Poco::JSON::Parser parser;
+			Poco::JSON::Object::Ptr root;
+
+			try
+			{
+				root = parser.parse(httpResponse.getMessage()).extract<Poco::JSON::Object::Ptr>();
+			}
+			catch (...)
+			{
+				return false;
+			}
+
+			if (root->has("generationSignature") && root->has("height") && root->has("baseTarget"))
+			{
+				miningInfo.gensig = root->get("generationSignature").convert<std::string>();
+				miningInfo.height = std::stoull(root->get("height").convert<std::string>());
+				miningInfo.baseTarget = std::stoull(root->get("baseTarget").convert<std::string>());
+				miningInfo.hasBlock = true;
+			}
+
+			if (root->has("targetDeadline"))
+			{
+				const auto targetDeadlineJson = root->get("targetDeadline");
+				miningInfo.hasTargetDeadline = true;
+
+				if (!targetDeadlineJson.isEmpty())
+					miningInfo.targetDeadline = targetDeadlineJson.convert<Poco::UInt64>();
+			}
+
+			return true;
 		}
 	}
 }
 
 Burst::Miner::Miner()
+	: accountCache_{MinerConfig::getConfig().getDatabasePath(), accounts_, [this](const Poco::UInt64 blocksWon)
+	  {
+		  data_.setBlocksWon(blocksWon);
+	  }},
+	  verifierNodes_(Numa::getNodeCount()),
+	  verificationQueues_{Numa::getNodeCount()}
 {}
 
 Burst::Miner::~Miner() = default;
 
-void Burst::Miner::run()
+void Burst::Miner::run(const Poco::Timestamp& startupTime)
 {
 	poco_ndc(Miner::run);
 	running_ = true;
+	startupTime_ = startupTime;
+	firstRound_ = true;
 	progressRead_ = std::make_shared<PlotReadProgress>();
 	progressVerify_ = std::make_shared<PlotReadProgress>();
 
-	progressRead_->progressChanged.add(Poco::delegate(this, &Miner::progressChanged));
-	progressVerify_->progressChanged.add(Poco::delegate(this, &Miner::progressChanged));
+	// the reader and verifier threads only count, the progress is shown with 10 Hz
+	progressTimer_.setPeriodicInterval(100);
+	progressTimer_.start(Poco::TimerCallback<Miner>(*this, &Miner::onProgressTimer));
 
 	auto& config = MinerConfig::getConfig();
 	auto errors = 0u;
@@ -112,18 +269,35 @@ void Burst::Miner::run()
 
 	MinerConfig::getConfig().printConsole();
 
+	accountCache_.setWallet(MinerConfig::getConfig().getWalletUrl());
+
 	// only create the thread pools and manager for mining if there is work to do (plot files)
 	if (!config.getPlotFiles().empty())
 	{
 		// manager
 		nonceSubmitterManager_ = std::make_unique<Poco::TaskManager>();
 
+		// retirements of a former run are obsolete, the pools are created from scratch
+		readerRetirement_.withdraw();
+
+		for (auto& node : verifierNodes_)
+		{
+			node.retirement.withdraw();
+			node.count = 0;
+		}
+
+		if (Numa::isActive())
+			log_system(MinerLogger::miner, "%z NUMA nodes, the buffers and workers are placed on the node of the plot dir",
+				Numa::getNodeCount());
+
 		// create the plot readers
-		MinerHelper::createWorker<PlotReader>(plotReaderPool_, plotReader_, MinerConfig::getConfig().getMaxPlotReaders(),
-			data_, progressRead_, progressVerify_, verificationQueue_, plotReadQueue_);
+		readerCount_ = MinerConfig::getConfig().getMaxPlotReaders();
+		MinerHelper::createPool(plotReaderPool_, plotReader_, readerCount_);
+		startPlotReaders(readerCount_);
 
-		// create the plot verifiers
-		createPlotVerifiers();
+		// create the plot verifiers, every node gets its share
+		MinerHelper::createPool(verifierPool_, verifier_, MinerConfig::getConfig().getMiningIntensity());
+		resizeVerifiers(MinerConfig::getConfig().getMiningIntensity());
 
 #ifndef USE_CUDA
 		if (config.getProcessorType() == "CUDA")
@@ -132,7 +306,8 @@ void Burst::Miner::run()
 #endif
 	}
 
-	wallet_ = MinerConfig::getConfig().getWalletUrl();
+	// the names, reward recipients and won blocks of the accounts are cached and refreshed in the background
+	loadAccounts();
 
 	const auto wakeUpTime = static_cast<long>(config.getWakeUpTime());
 
@@ -158,6 +333,14 @@ void Burst::Miner::run()
 
 	while (running_)
 	{
+		// the settings are reapplied between two mining info requests, the running round goes on
+		if (softRestart_.exchange(false) && !softRestart())
+		{
+			restart_ = true;
+			stop();
+			break;
+		}
+
 		try
 		{
 			const auto& altMiningInfoUrls = MinerConfig::getConfig().getMiningInfoUrlAlt();
@@ -206,9 +389,10 @@ void Burst::Miner::run()
 		std::this_thread::sleep_for(std::chrono::seconds(MinerConfig::getConfig().getMiningInfoInterval()));
 	}
 
-	if (wakeUpTime > 0)
-		wakeUpTimer_.stop();
+	// the wake up interval could have been changed by a soft restart
+	wakeUpTimer_.stop();
 
+	progressTimer_.stop();
 	running_ = false;
 }
 
@@ -218,19 +402,109 @@ void Burst::Miner::stop()
 
 	// stop plot reader
 	if (plotReader_ != nullptr)
-		shutDownWorker(*plotReaderPool_, *plotReader_, plotReadQueue_);
+		shutDownWorker(*plotReaderPool_, *plotReader_, {&plotReadQueue_});
 
 	// stop verifier
 	if (verifier_ != nullptr)
-		shutDownWorker(*verifierPool_, *verifier_, verificationQueue_);
+		shutDownWorker(*verifierPool_, *verifier_, verificationQueues_.getQueues());
 	
 	running_ = false;
 }
 
 void Burst::Miner::restart()
 {
-	restart_ = true;
-	stop();
+	// the mining loop tries to reapply the settings first and rebuilds the miner only if it has to
+	softRestart_ = true;
+}
+
+bool Burst::Miner::softRestart()
+{
+	poco_ndc(Miner::softRestart);
+
+	auto& config = MinerConfig::getConfig();
+	const auto before = MinerHelper::RestartSettings::fromConfig(config);
+
+	log_system(MinerLogger::miner, "Reapplying the configuration...");
+
+	if (config.readConfigFile(config.getPath(), true) != ReadConfigFileResult::Ok)
+	{
+		log_error(MinerLogger::miner, "Could not read the configuration, restarting the miner completely");
+		return false;
+	}
+
+	const auto after = MinerHelper::RestartSettings::fromConfig(config);
+
+	if (before.needsFullRestart(after) || (plotReader_ == nullptr && !config.getPlotFiles().empty()))
+	{
+		log_system(MinerLogger::miner, "The webserver, database, GPU or plot settings need a complete restart");
+		return false;
+	}
+
+	// the limits of the buffers are changed in place, the buffers in use stay valid
+	PlotReader::globalBufferSize.setMax(config.getMaxBufferSize());
+
+	{
+		Poco::Mutex::ScopedLock lock(workerMutex_);
+
+		if (plotReader_ != nullptr)
+		{
+			resizeWorkers(readerCount_, config.getMaxPlotReaders(), readerRetirement_, plotReadQueue_,
+				[this](const unsigned count)
+				{
+					startPlotReaders(count);
+				});
+
+			if (before.needsNewVerifiers(after))
+			{
+				// the verifiers are replaced by the ones of the new backend, the queued work is kept
+				shutDownWorker(*verifierPool_, *verifier_, verificationQueues_.getQueues());
+				verifier_.reset();
+
+				for (auto& node : verifierNodes_)
+				{
+					node.retirement.withdraw();
+					node.count = 0;
+				}
+
+				MinerHelper::createPool(verifierPool_, verifier_, config.getMiningIntensity());
+				resizeVerifiers(config.getMiningIntensity());
+			}
+			else
+				resizeVerifiers(config.getMiningIntensity());
+		}
+	}
+
+	if (before.miningInfoUrl != after.miningInfoUrl)
+		miningInfoSession_.reset();
+
+	// the served mining info contains the target deadline
+	if (before.targetDeadline != after.targetDeadline)
+		miningInfoCache_.invalidate();
+
+	if (before.walletUrl != after.walletUrl)
+		accountCache_.setWallet(config.getWalletUrl());
+
+	if (before.wakeUpTime != after.wakeUpTime)
+	{
+		wakeUpTimer_.stop();
+
+		if (after.wakeUpTime > 0)
+		{
+			wakeUpTimer_.setPeriodicInterval(static_cast<long>(after.wakeUpTime) * 1000);
+			wakeUpTimer_.start(Poco::TimerCallback<Miner>(*this, &Miner::onWakeUp));
+		}
+	}
+
+	loadAccounts();
+
+	if (const auto block = data_.getBlockData())
+	{
+		block->refreshConfig();
+		block->refreshPlotDirs();
+	}
+
+	log_success(MinerLogger::miner, "Configuration reapplied");
+	return true;
 }
 
 void Burst::Miner::addPlotReadNotifications(bool wakeUpCall)
@@ -243,12 +517,10 @@ void Burst::Miner::addPlotReadNotifications(bool wakeUpCall)
 		notification->scoopNum = getScoopNum();
 		notification->blockheight = getBlockheight();
 		notification->baseTarget = getBaseTarget();
+		notification->epoch = PlotReader::roundEpoch.get();
+		notification->node = Numa::getNodeOfPath(plotDir.getPath());
 		notification->type = plotDir.getType();
 		notification->wakeUpCall = wakeUpCall;
-
-		for (const auto& plotFile : plotDir.getPlotfiles(true))
-			accounts_.getAccount(plotFile->getAccountId(), wallet_, true);
-
 		return notification;
 	};
 
@@ -294,20 +566,54 @@ void Burst::Miner::updateGensig(const std::string& gensigStr, Poco::UInt64 block
 {
 	poco_ndc(Miner::updateGensig);
 
+	const Poco::Timestamp gensigDetected;
+
 	try
 	{
+		Tracing::setBlock(blockHeight);
+
+		// every read and verification of the old round stops at its next check
+		PlotReader::roundEpoch.next();
+
 		// stop all reading processes if any
 		if (!MinerConfig::getConfig().getPlotFiles().empty())
 		{
+			auto verificationQueueSize = 0;
+
+			for (const auto queue : verificationQueues_.getQueues())
+				verificationQueueSize += queue->size();
+
 			log_debug(MinerLogger::miner, "Plot-read-queue: %d (%d reader), verification-queue: %d (%d verifier)",
-				plotReadQueue_.size(), plotReader_->count(), verificationQueue_.size(), verifier_->count());
+				plotReadQueue_.size(), plotReader_->count(), verificationQueueSize, verifier_->count());
 			log_debug(MinerLogger::miner, "Allocated memory: %s", memToString(PlotReader::globalBufferSize.getSize(), 1));
 		
 			PlotReader::globalBufferSize.setMax(MinerConfig::getConfig().getMaxBufferSize());
 		}
 		
-		// clear the plot read queue
-		plotReadQueue_.clear();
+		// clear the plot read queue, but keep the wake ups of retiring workers
+		MinerHelper::drainQueue(plotReadQueue_, [](Poco::Notification&) {});
+
+		// the read chunks of the old round are not verified anymore, their buffers are free for the new round
+		Poco::UInt64 droppedChunks = 0;
+
+		for (const auto queue : verificationQueues_.getQueues())
+			MinerHelper::drainQueue(*queue, [&droppedChunks](Poco::Notification& notification)
+			{
+				const auto verification = dynamic_cast<VerifyNotification*>(&notification);
+
+				if (verification == nullptr)
+					return;
+
+				PlotReader::globalBufferSize.free(verification->buffer, verification->node);
+				++droppedChunks;
+			});
+
+		if (droppedChunks > 0)
+		{
+			Metrics::counter("creepminer_stale_chunks_dropped_total",
+			                 "Chunks of an old round, that were dropped without verifying them", {{"stage", "queue"}}).add(droppedChunks);
+			log_debug(MinerLogger::miner, "Dropped %Lu read chunks of the last round", droppedChunks);
+		}
 
 		// Set dynamic targetDL for this round if a submitProbability is given
 		if (MinerConfig::getConfig().getSubmitProbability() > 0.)
@@ -339,8 +645,21 @@ void Burst::Miner::updateGensig(const std::string& gensigStr, Poco::UInt64 block
 
 		// setup new block-data
 		auto block = data_.startNewBlock(blockHeight, baseTarget, gensigStr, MinerConfig::getConfig().getTargetDeadline(TargetDeadlineType::Local));
+		miningInfoCache_.invalidate();
 		setIsProcessing(true);
 
+		block->getTimeline().attachQueues(&plotReadQueue_, &verificationQueues_.getQueues());
+		block->getTimeline().record(RoundTimeline::Stage::GensigDetected, "", gensigDetected);
+
+		if (firstRound_)
+		{
+			firstRound_ = false;
+			log_system(MinerLogger::miner, "First round started %ss after startup",
+				Poco::NumberFormatter::format(static_cast<double>(startupTime_.elapsed()) / 1000000, 3));
+			Metrics::histogram("creepminer_time_to_first_round_seconds", "Time from the start of the miner to its first round",
+				{}, Metrics::latencyBounds(), 1e-6).observe(startupTime_.elapsed());
+		}
+
 		// printing block info and transfer it to local server
 		{
 			const auto difficulty = block->getDifficulty();
@@ -369,27 +688,33 @@ void Burst::Miner::updateGensig(const std::string& gensigStr, Poco::UInt64 block
 			);
 
 			data_.getBlockData()->refreshBlockEntry();
+			data_.getBlockData()->refreshLastRoundTimeline();
 		}
 
-		if (MinerConfig::getConfig().isRescanningEveryBlock())
-			MinerConfig::getConfig().rescanPlotfiles();
+		if (MinerConfig::getConfig().isRescanningEveryBlock() && MinerConfig::getConfig().rescanPlotfiles())
+			loadAccounts();
 
+		// the round time starts before the sampler can see the new round
+		startPoint_ = std::chrono::high_resolution_clock::now();
 		progressRead_->reset(blockHeight, MinerConfig::getConfig().getTotalPlotsize());
 		progressVerify_->reset(blockHeight, MinerConfig::getConfig().getTotalPlotsize());
 
 		PlotSizes::nextRound();
 		PlotSizes::refresh(Poco::Net::IPAddress{"127.0.0.1"});
-		startPoint_ = std::chrono::high_resolution_clock::now();
 
 		addPlotReadNotifications();
+		block->getTimeline().record(RoundTimeline::Stage::GensigUpdated);
 
-		data_.getWonBlocksAsync(wallet_, accounts_);
+		// the account cache fetches only the new won blocks in its own thread
+		accountCache_.scanBlocks();
 
 		// why we start a new thread to gather the last winner:
 		// it could be slow and is not necessary for the whole process
 		// so show it when it's done
-		if (blockHeight > 0 && wallet_.isActive())
-			block->getLastWinnerAsync(wallet_, accounts_);
+		const auto wallet = accountCache_.getWallet();
+
+		if (blockHeight > 0 && wallet->isActive())
+			block->getLastWinnerAsync(wallet, accounts_);
 	}
 	catch (const Poco::Exception& e)
 	{
@@ -414,7 +739,7 @@ std::shared_ptr<Burst::Deadline> Burst::Miner::addDeadline(Deadline deadline, No
 		}
 		else
 		{
-			const auto targetDeadline = MinerConfig::getConfig().getTargetDeadline();
+			const auto targetDeadline = MinerConfig::getConfig().getSnapshot()->getTargetDeadline();
 			const auto tooHigh = targetDeadline > 0 && deadline.getDeadline() > targetDeadline;
 
 			auto block = data_.getBlockData();
@@ -446,6 +771,7 @@ std::shared_ptr<Burst::Deadline> Burst::Miner::addDeadline(Deadline deadline, No
 					}
 					else
 					{
+						block->getTimeline().recordOnce(RoundTimeline::Stage::FirstDeadlineFound);
 						return addedDeadline;
 					}
 				}
@@ -542,61 +868,51 @@ bool Burst::Miner::getMiningInfo(const Url& url)
 		HTTPRequest requestData { HTTPRequest::HTTP_GET, "/burst?requestType=getMiningInfo", HTTPRequest::HTTP_1_1 };
 		requestData.setKeepAlive(true);
 
+		Poco::Timestamp requestStart;
 		auto response = request.send(requestData);
 		std::string responseData;
-		
-		if (response.receive(responseData))
+		const auto received = response.receive(responseData);
+
+		Metrics::histogram("creepminer_mining_info_seconds", "Time to fetch the mining info",
+		                   {{"source", url.getCanonical()}}, Metrics::latencyBounds(), 1e-6).observe(requestStart.elapsed());
+
+		if (!received)
+			Metrics::counter("creepminer_mining_info_errors_total", "Failed mining info requests",
+			                 {{"source", url.getCanonical()}}).add();
+
+		if (received)
 		{
 			try
 			{
 				if (responseData.empty())
 					return false;
 
-				HttpResponse httpResponse(responseData);
-				Poco::JSON::Parser parser;
-				Poco::JSON::Object::Ptr root;
+				MinerHelper::MiningInfo miningInfo;
 
-				try
-				{
-					root = parser.parse(httpResponse.getMessage()).extract<Poco::JSON::Object::Ptr>();
-				}
-				catch (...)
-				{
+				if (!MinerHelper::parseMiningInfo(responseData, miningInfo))
 					return false;
-				}
 
-				std::string gensig;
-
-				if (root->has("generationSignature"))
+				if (miningInfo.hasBlock)
 				{
-					gensig = root->get("generationSignature").convert<std::string>();
+					const auto& gensig = miningInfo.gensig;
 
-					if ((data_.getBlockData() == nullptr || gensig != data_.getBlockData()->getGensigStr()) &&
-						root->has("height"))
+					if (data_.getBlockData() == nullptr || gensig != data_.getBlockData()->getGensigStr())
 					{
-						std::string baseTargetStr;
-
-						const std::string newBlockHeightStr = root->get("height");
-						const auto newBlockHeight = std::stoull(newBlockHeightStr);
+						const auto newBlockHeight = miningInfo.height;
 
-						if (root->has("baseTarget"))
-							baseTargetStr = root->get("baseTarget").convert<std::string>();
-
-						if (root->has("targetDeadline"))
+						if (miningInfo.hasTargetDeadline)
 						{
 							// remember the current pool target deadline
 							const auto targetDeadlinePoolBefore = MinerConfig::getConfig().getTargetDeadline(TargetDeadlineType::Pool);
 
-							// get the target deadline from pool
-							auto targetDeadlinePoolJson = root->get("targetDeadline");
-							Poco::UInt64 targetDeadlinePool = 0;
-							
 							// update the new pool target deadline
-							if (!targetDeadlinePoolJson.isEmpty())
-								targetDeadlinePool = targetDeadlinePoolJson.convert<Poco::UInt64>();
+							const auto targetDeadlinePool = miningInfo.targetDeadline;
 
 							MinerConfig::getConfig().setTargetDeadline(targetDeadlinePool, TargetDeadlineType::Pool);
 
+							if (targetDeadlinePoolBefore != targetDeadlinePool)
+								miningInfoCache_.invalidate();
+
 							// if its changed, print it
 							if (MinerConfig::getConfig().getSubmitProbability() == 0.)
 							{
@@ -626,7 +942,7 @@ bool Burst::Miner::getMiningInfo(const Url& url)
 							}
 						}
 
-						updateGensig(gensig, newBlockHeight, std::stoull(baseTargetStr));
+						updateGensig(gensig, newBlockHeight, miningInfo.baseTarget);
 					}
 				}
 
@@ -660,25 +976,44 @@ bool Burst::Miner::getMiningInfo(const Url& url)
 	}
 }
 
-void Burst::Miner::shutDownWorker(Poco::ThreadPool& threadPool, Poco::TaskManager& taskManager, Poco::NotificationQueue& queue) const
+void Burst::Miner::shutDownWorker(Poco::ThreadPool& threadPool, Poco::TaskManager& taskManager,
+                                  const std::vector<Poco::NotificationQueue*>& queues) const
 {
 	Poco::Mutex::ScopedLock lock(workerMutex_);
-	queue.wakeUpAll();
+	// cancelled first, so a woken worker sees it and does not wait again
 	taskManager.cancelAll();
+
+	// every worker of the pool could wait on any of the queues, one wake up for each of them
+	const auto workers = static_cast<unsigned>(taskManager.count());
+
+	for (const auto queue : queues)
+		WorkerNotification::post(workers, *queue);
+
 	threadPool.stopAll();
 	threadPool.joinAll();
 }
 
 namespace Burst
 {
-	std::mutex progressMutex;
+	// only accessed by the progress timer thread
 	Progress progress;
+	Poco::UInt64 processedBlockheight = 0;
 
-	void showProgress(PlotReadProgress& progressRead, PlotReadProgress& progressVerify, MinerData& data, Poco::UInt64 blockheight,
+	void showProgress(PlotReadProgress& progressRead, PlotReadProgress& progressVerify, MinerData& data,
 		std::chrono::high_resolution_clock::time_point& startPoint,
 		const std::function<void(Poco::UInt64, double)>& blockProcessed)
 	{
-		std::lock_guard<std::mutex> lock(progressMutex);
+		const auto block = data.getBlockData();
+
+		if (block == nullptr)
+			return;
+
+		// the height of the progress, not of the miner: a new block is published before the progress is reset
+		const auto blockheight = progressRead.getBlockheight();
+
+		// between the resets of both progresses, they belong to different rounds
+		if (blockheight != progressVerify.getBlockheight())
+			return;
 
 		const auto readProgressPercent = progressRead.getProgress();
 		const auto verifyProgressPercent = progressVerify.getProgress();
@@ -689,7 +1024,7 @@ namespace Burst
 		const auto timeDiffSeconds = std::chrono::duration<double>(timeDiff);
 
 		const auto readProgressChanged = progress.read != readProgressPercent;
-		const auto verifyProgressChanged = progress.verify != readProgressPercent;
+		const auto verifyProgressChanged = progress.verify != verifyProgressPercent;
 
 		if (readProgressChanged || verifyProgressChanged)
 		{
@@ -701,21 +1036,25 @@ namespace Burst
 				count();
 			
 			MinerLogger::writeProgress(progress);
-			data.getBlockData()->setProgress(readProgressPercent, verifyProgressPercent, blockheight);
+			block->setProgress(readProgressPercent, verifyProgressPercent, blockheight);
 			
-			if (readProgressPercent == 100.f && verifyProgressPercent == 100.f && blockProcessed != nullptr)
+			// the sampler sees a finished round until the next one starts, but it is processed only once
+			if (readProgressPercent == 100.f && verifyProgressPercent == 100.f && blockProcessed != nullptr &&
+				processedBlockheight != blockheight)
 			{
+				processedBlockheight = blockheight;
 				blockProcessed(blockheight, timeDiffSeconds.count());
-				progress.read = 0.f;
-				progress.verify = 0.f;
 			}
 		}
 	}
 }
 
-void Burst::Miner::progressChanged(float &progress)
+void Burst::Miner::onProgressTimer(Poco::Timer& timer)
 {
-	showProgress(*progressRead_, *progressVerify_, getData(), getBlockheight(), startPoint_,
+	if (progressRead_ == nullptr || progressVerify_ == nullptr)
+		return;
+
+	showProgress(*progressRead_, *progressVerify_, getData(), startPoint_,
 	             [this](Poco::UInt64 blockHeight, double roundTime) { onRoundProcessed(blockHeight, roundTime); });
 }
 
@@ -737,6 +1076,9 @@ void Burst::Miner::onRoundProcessed(Poco::UInt64 blockHeight, double roundTime)
 			return;
 
 		block->setRoundTime(roundTime);
+		block->getTimeline().snapshotLast();
+		Metrics::histogram("creepminer_round_seconds", "Time to process all plot files of a round",
+		                   {}, MetricHistogram::exponentialBounds(1000, 2, 10), 1e-3).observe(static_cast<Poco::UInt64>(roundTime * 1000));
 		const auto bestDeadline = block->getBestDeadline(BlockData::DeadlineSearchType::Found);
 
 		log_information(MinerLogger::miner, std::string(50, '-') + "\n"
@@ -755,6 +1097,19 @@ void Burst::Miner::onRoundProcessed(Poco::UInt64 blockHeight, double roundTime)
 	}
 }
 
+std::shared_ptr<Burst::Deadline> Burst::Miner::getBestFound(Poco::UInt64 accountId, Poco::UInt64 blockHeight) const
+{
+	poco_ndc(Miner::getBestFound);
+
+	const auto block = data_.getBlockData();
+
+	if (block == nullptr ||
+		blockHeight != block->getBlockheight())
+		return nullptr;
+
+	return block->getBestDeadline(accountId, BlockData::DeadlineSearchType::Found);
+}
+
 std::shared_ptr<Burst::Deadline> Burst::Miner::getBestSent(Poco::UInt64 accountId, Poco::UInt64 blockHeight) const
 {
 	poco_ndc(Miner::getBestSent);
@@ -786,34 +1141,39 @@ Burst::MinerData& Burst::Miner::getData()
 	return data_;
 }
 
+Burst::MiningInfoCache& Burst::Miner::getMiningInfoCache()
+{
+	return miningInfoCache_;
+}
+
 std::shared_ptr<Burst::Account> Burst::Miner::getAccount(AccountId id, bool persistent)
 {
-	return accounts_.getAccount(id, wallet_, persistent);
+	return accounts_.getAccount(id, accountCache_.getWallet(), persistent);
 }
 
-void Burst::Miner::createPlotVerifiers()
+void Burst::Miner::createPlotVerifiers(const size_t node, const unsigned count)
 {
 	const auto& processorType = MinerConfig::getConfig().getProcessorType();
 	auto cpuInstructionSet = MinerConfig::getConfig().getCpuInstructionSet();
 	auto forceCpu = false, fallback = false;
-	const auto createWorker = [this](std::function<void(std::unique_ptr<Poco::ThreadPool>&,
-	                                                    std::unique_ptr<Poco::TaskManager>&,
-	                                                    size_t, Miner&, Poco::NotificationQueue&)> function)
+	const auto createWorker = [this, node, count](std::function<void(Poco::ThreadPool&, Poco::TaskManager&,
+	                                                                 size_t, Miner&, Poco::NotificationQueue&,
+	                                                                 WorkerRetirement&, size_t)> function)
 	{
-		function(verifierPool_, verifier_, MinerConfig::getConfig().getMiningIntensity(), *this, verificationQueue_);
+		function(*verifierPool_, *verifier_, count, *this, verificationQueues_.getQueue(node), verifierNodes_[node].retirement, node);
 	};
 
 	if (processorType == "CUDA")
 	{
 		if (Settings::cuda)
-			createWorker(MinerHelper::createWorkerDefault<PlotVerifierCuda>);
+			createWorker(MinerHelper::startWorkerDefault<PlotVerifierCuda>);
 		else
 			forceCpu = true;
 	}
 	else if (processorType == "OPENCL")
 	{
 		if (Settings::openCl)
-			createWorker(MinerHelper::createWorkerDefault<PlotVerifierOpencl>);
+			createWorker(MinerHelper::startWorkerDefault<PlotVerifierOpencl>);
 		else
 			forceCpu = true;
 	}
@@ -821,13 +1181,13 @@ void Burst::Miner::createPlotVerifiers()
 	if (processorType == "CPU" || forceCpu)
 	{
 		if (cpuInstructionSet == "SSE4" && Settings::sse4)
-			createWorker(MinerHelper::createWorkerDefault<PlotVerifierSse4>);
+			createWorker(MinerHelper::startWorkerDefault<PlotVerifierSse4>);
 		else if (cpuInstructionSet == "AVX" && Settings::avx)
-			createWorker(MinerHelper::createWorkerDefault<PlotVerifierAvx>);
+			createWorker(MinerHelper::startWorkerDefault<PlotVerifierAvx>);
 		else if (cpuInstructionSet == "AVX2" && Settings::avx2)
-			createWorker(MinerHelper::createWorkerDefault<PlotVerifierAvx2>);
+			createWorker(MinerHelper::startWorkerDefault<PlotVerifierAvx2>);
 		else if (cpuInstructionSet == "SSE2")
-			createWorker(MinerHelper::createWorkerDefault<PlotVerifierSse2>);
+			createWorker(MinerHelper::startWorkerDefault<PlotVerifierSse2>);
 		else
 			fallback = true;
 	}
@@ -836,14 +1196,14 @@ void Burst::Miner::createPlotVerifiers()
 		cpuInstructionSet = "SSE2";
 
 	if (forceCpu)
-	{
 		log_warning(MinerLogger::miner, "You are using the processor type %s with the instruction set %s,\n"
 			"but your miner is compiled without that feature!\n"
 			"As a fallback solution your CPU with the instruction set %s is used.", processorType, MinerConfig::getConfig().
 			getCpuInstructionSet(), cpuInstructionSet);
-		
-		createWorker(MinerHelper::createWorkerDefault<PlotVerifierSse2>);
-	}
+
+	// the workers are added to the running pool, so only one set of verifiers must be started
+	if (fallback)
+		createWorker(MinerHelper::startWorkerDefault<PlotVerifierSse2>);
 }
 
 void Burst::Miner::setMiningIntensity(unsigned intensity)
@@ -851,13 +1211,16 @@ void Burst::Miner::setMiningIntensity(unsigned intensity)
 	Poco::Mutex::ScopedLock lock(workerMutex_);
 
 	// dont change it if its the same intensity
-	// changing it is a heavy task
 	if (MinerConfig::getConfig().getMiningIntensity() == intensity)
 		return;
 
-	shutDownWorker(*verifierPool_, *verifier_, verificationQueue_);
 	MinerConfig::getConfig().setMininigIntensity(intensity);
-	createPlotVerifiers();
+
+	// no plot files, no verifiers
+	if (verifier_ == nullptr)
+		return;
+
+	resizeVerifiers(MinerConfig::getConfig().getMiningIntensity());
 }
 
 void Burst::Miner::setMaxPlotReader(unsigned max_reader)
@@ -865,14 +1228,64 @@ void Burst::Miner::setMaxPlotReader(unsigned max_reader)
 	Poco::Mutex::ScopedLock lock(workerMutex_);
 
 	// dont change it if its the same reader count
-	// changing it is a heavy task
 	if (MinerConfig::getConfig().getMaxPlotReaders() == max_reader)
 		return;
 
-	shutDownWorker(*plotReaderPool_, *plotReader_, plotReadQueue_);
 	MinerConfig::getConfig().setMaxPlotReaders(max_reader);
-	MinerHelper::createWorker<PlotReader>(plotReaderPool_, plotReader_, MinerConfig::getConfig().getMaxPlotReaders(),
-		data_, progressRead_, progressVerify_, verificationQueue_, plotReadQueue_);
+
+	// no plot files, no readers
+	if (plotReader_ == nullptr)
+		return;
+
+	resizeWorkers(readerCount_, MinerConfig::getConfig().getMaxPlotReaders(), readerRetirement_, plotReadQueue_,
+		[this](const unsigned count)
+		{
+			startPlotReaders(count);
+		});
+}
+
+void Burst::Miner::resizeWorkers(unsigned& count, const unsigned target, WorkerRetirement& retirement,
+                                 Poco::NotificationQueue& queue, const std::function<void(unsigned)>& startWorkers) const
+{
+	if (target > count)
+	{
+		const auto missing = target - count;
+
+		// workers that were asked to retire but are still busy simply keep on working
+		const auto pending = retirement.withdraw();
+		const auto kept = std::min(pending, missing);
+
+		if (pending > kept)
+			retirement.request(pending - kept, queue);
+
+		if (missing > kept)
+			startWorkers(missing - kept);
+	}
+	else if (target < count)
+		retirement.request(count - target, queue);
+
+	log_debug(MinerLogger::miner, "Resized the worker pool from %u to %u workers", count, target);
+	count = target;
+}
+
+void Burst::Miner::resizeVerifiers(const unsigned count)
+{
+	std::vector<unsigned> verifiers;
+
+	for (size_t node = 0; node < verifierNodes_.size(); ++node)
+	{
+		resizeWorkers(verifierNodes_[node].count, MinerHelper::getVerifierShare(count, node, verifierNodes_.size()),
+			verifierNodes_[node].retirement, verificationQueues_.getQueue(node),
+			[this, node](const unsigned nodeCount)
+			{
+				createPlotVerifiers(node, nodeCount);
+			});
+
+		verifiers.emplace_back(verifierNodes_[node].count);
+	}
+
+	// the chunks of the nodes without verifiers are verified by the next node with verifiers
+	verificationQueues_.setVerifiers(verifiers);
 }
 
 void Burst::Miner::setMaxBufferSize(Poco::UInt64 size)
@@ -886,6 +1299,9 @@ void Burst::Miner::rescanPlotfiles()
 	// rescan the plot files...
 	if (MinerConfig::getConfig().rescanPlotfiles())
 	{
+		// new plot files could belong to new accounts
+		loadAccounts();
+
 		// we send the new settings (size could be changed)
 		data_.getBlockData()->refreshConfig();
 
@@ -898,6 +1314,19 @@ void Burst::Miner::rescanPlotfiles()
 	}
 }
 
+void Burst::Miner::startPlotReaders(const unsigned count)
+{
+	MinerHelper::startWorker<PlotReader>(*plotReaderPool_, *plotReader_, count,
+		data_, progressRead_, progressVerify_, verificationQueues_, plotReadQueue_, readerRetirement_);
+}
+
+void Burst::Miner::loadAccounts()
+{
+	// the accounts get their cached data, the cache fetches the unknown ones in the background
+	for (const auto& plotFile : MinerConfig::getConfig().getPlotFiles())
+		accountCache_.track(plotFile->getAccountId());
+}
+
 void Burst::Miner::setIsProcessing(bool isProc)
 {
 	Poco::Mutex::ScopedLock lock(workerMutex_);
@@ -909,5 +1338,5 @@ bool Burst::Miner::isPoC2() const
 {
 	const auto block = data_.getBlockData();
 	poco_check_ptr(block);
-	return block->getBlockheight() >= MinerConfig::getConfig().getPoc2StartBlock();
+	return block->getBlockheight() >= MinerConfig::getConfig().getSnapshot()->poc2StartBlock;
 }
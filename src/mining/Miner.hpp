@@ -32,6 +32,13 @@
 #include "WorkerList.hpp"
 #include "network/Response.hpp"
 #include <Poco/Timer.h>
+#include <Poco/Timestamp.h>
+#include "webserver/MiningInfoCache.hpp"
+#include "plots/PlotReader.hpp"
+#include "wallet/AccountCache.hpp"
+#include <functional>
+#include <atomic>
+#include <vector>
 
 namespace Poco
 {
@@ -53,8 +60,18 @@ namespace Burst
 		Miner();
 		~Miner();
 
-		void run();
+		/**
+		 * \brief Starts mining and blocks until the miner is stopped.
+		 * \param startupTime The time the startup began, used to report the time to the first round.
+		 */
+		void run(const Poco::Timestamp& startupTime = Poco::Timestamp());
 		void stop();
+
+		/**
+		 * \brief Requests a restart, that reapplies the configuration file.
+		 * The buffers, the plot files, the connections and the block data are kept if possible,
+		 * otherwise the miner is stopped and wantRestart() returns true.
+		 */
 		void restart();
 		void addPlotReadNotifications(bool wakeUpCall = false);
 		bool wantRestart() const;
@@ -71,11 +88,13 @@ namespace Burst
 		std::shared_ptr<Deadline> addDeadline(Deadline deadline, NonceConfirmation& confirmation);
 		NonceConfirmation submitDeadline(std::shared_ptr<Deadline> deadline);
 
+		std::shared_ptr<Deadline> getBestFound(Poco::UInt64 accountId, Poco::UInt64 blockHeight) const;
 		std::shared_ptr<Deadline> getBestSent(Poco::UInt64 accountId, Poco::UInt64 blockHeight) const;
 		std::shared_ptr<Deadline> getBestConfirmed(Poco::UInt64 accountId, Poco::UInt64 blockHeight) const;
 		MinerData& getData();
+		MiningInfoCache& getMiningInfoCache();
 		std::shared_ptr<Account> getAccount(AccountId id, bool persistent = false);
-		void createPlotVerifiers();
+		void createPlotVerifiers(size_t node, unsigned count);
 
 		void setMiningIntensity(unsigned intensity);
 		void setMaxPlotReader(unsigned max_reader);
@@ -88,23 +107,73 @@ namespace Burst
 	private:
 		bool getMiningInfo(const Url& url);
 		void shutDownWorker(Poco::ThreadPool& threadPool, Poco::TaskManager& taskManager,
-		                    Poco::NotificationQueue& queue) const;
-		void progressChanged(float& progress);
+		                    const std::vector<Poco::NotificationQueue*>& queues) const;
+		void onProgressTimer(Poco::Timer& timer);
 		void onWakeUp(Poco::Timer& timer);
 		void onRoundProcessed(Poco::UInt64 blockHeight, double roundTime);
 
+		/**
+		 * \brief Adds the accounts of all plot files to the account cache.
+		 * Their data is fetched by the cache in the background, so this does not block the mining.
+		 */
+		void loadAccounts();
+
+		/**
+		 * \brief Reads the configuration file again and rebuilds only the parts whose settings changed.
+		 * \return true, if the settings were applied, false if the whole miner needs to be rebuilt.
+		 */
+		bool softRestart();
+		void startPlotReaders(unsigned count);
+
+		/**
+		 * \brief Grows or shrinks a running worker pool without stopping it.
+		 * \param count The current amount of workers, is set to the target.
+		 * \param target The wanted amount of workers.
+		 * \param retirement The retirement the workers of the pool are asking.
+		 * \param queue The queue the workers of the pool are waiting on.
+		 * \param startWorkers Starts the given amount of additional workers.
+		 */
+		void resizeWorkers(unsigned& count, unsigned target, WorkerRetirement& retirement, Poco::NotificationQueue& queue,
+		                   const std::function<void(unsigned)>& startWorkers) const;
+
+		/**
+		 * \brief Grows or shrinks the verifiers of all NUMA nodes, every node gets its share of them.
+		 * \param count The wanted amount of verifiers of all nodes.
+		 */
+		void resizeVerifiers(unsigned count);
+
+		/**
+		 * \brief The verifiers of one NUMA node, they are pinned to it and verify the chunks in its buffers.
+		 * Their queue is the one of the node in the verification queues.
+		 */
+		struct VerifierNode
+		{
+			WorkerRetirement retirement;
+			unsigned count = 0;
+		};
+
 		bool running_ = false, restart_ = false, isProcessing_ = false;
+		std::atomic<bool> softRestart_{false};
 		MinerData data_;
+		MiningInfoCache miningInfoCache_;
 		std::shared_ptr<PlotReadProgress> progressRead_, progressVerify_;
 		std::unique_ptr<Poco::Net::HTTPClientSession> miningInfoSession_;
 		Accounts accounts_;
-		Wallet wallet_;
+		// owns the wallet, that is shared with the accounts
+		AccountCache accountCache_;
 		std::unique_ptr<Poco::TaskManager> nonceSubmitterManager_, plotReader_, verifier_;
 		Poco::NotificationQueue plotReadQueue_;
-		Poco::NotificationQueue verificationQueue_;
+		std::vector<VerifierNode> verifierNodes_;
+		VerificationQueues verificationQueues_;
 		std::unique_ptr<Poco::ThreadPool> verifierPool_, plotReaderPool_;
+		WorkerRetirement readerRetirement_;
+		unsigned readerCount_ = 0;
 		Poco::Timer wakeUpTimer_;
+		// samples the progress counters and drives the console, the web UI and the round completion
+		Poco::Timer progressTimer_;
 		mutable Poco::Mutex workerMutex_;
 		std::chrono::high_resolution_clock::time_point startPoint_;
+		Poco::Timestamp startupTime_;
+		bool firstRound_ = true;
 	};
 }
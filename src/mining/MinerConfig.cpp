@@ -46,9 +46,37 @@
 #include <Poco/Crypto/CipherFactory.h>
 #include <Poco/Crypto/CipherKey.h>
 #include <Poco/Crypto/Cipher.h>
+#include <Poco/NumberFormatter.h>
+#include <Poco/Timestamp.h>
+#include <future>
+#include <algorithm>
+#include <tuple>
+#include <map>
+#include <thread>
+#ifdef __linux__
+  #include <sys/stat.h>
+#endif
 
 const std::string Burst::Passphrase::delimiter = "::::";
 
+namespace Burst
+{
+	namespace
+	{
+		std::string getDeviceOfPath(const std::string& path)
+		{
+#ifdef __linux__
+			struct stat status;
+
+			if (stat(path.c_str(), &status) == 0)
+				return std::to_string(S_ISBLK(status.st_mode) ? status.st_rdev : status.st_dev);
+#endif
+			// without the device id the drive of the path stands for the device
+			return Poco::Path{path}.absolute().getDevice();
+		}
+	}
+}
+
 void Burst::MinerConfig::rescan()
 {
 	readConfigFile(configPath_);
@@ -63,6 +91,9 @@ bool Burst::MinerConfig::rescanPlotfiles()
 	for (auto& plotDir : plotDirs_)
 		plotDir->rescan();
 
+	// the effective buffer size depends on the biggest stagger
+	publishSnapshot();
+
 	const auto oldPlotsHash = plotsHash_;
 	recalculatePlotsHash();
 
@@ -77,52 +108,62 @@ bool Burst::MinerConfig::rescanPlotfiles()
 
 void Burst::MinerConfig::checkPlotOverlaps() const
 {
-	Poco::Mutex::ScopedLock lock(mutex_);
 	Poco::UInt64 totalOverlaps = 0;
+	Poco::Timestamp timeStart;
 
-	const auto plotFiles = getPlotFiles();
-	const auto numPlots = plotFiles.size();
+	// the check works on a copy, so it does not block the config while the miner is already running
+	auto plotFiles = getPlotFiles();
 
-	if (numPlots == 0)
+	if (plotFiles.empty())
 		return;
 
 	log_system(MinerLogger::config, "Checking local plots for overlaps...");
 
-	for (auto iterOne = plotFiles.begin(); iterOne != plotFiles.end(); ++iterOne)
+	// only files of the same account can overlap, so we sweep over the sorted nonce intervals of every account
+	std::sort(plotFiles.begin(), plotFiles.end(), [](const std::shared_ptr<PlotFile>& lhs, const std::shared_ptr<PlotFile>& rhs)
+	{
+		return std::make_tuple(lhs->getAccountId(), lhs->getNonceStart()) <
+			std::make_tuple(rhs->getAccountId(), rhs->getNonceStart());
+	});
+
+	// the files that started before the current one and still reach into it
+	std::vector<const PlotFile*> open;
+
+	for (auto iter = plotFiles.begin(); iter != plotFiles.end(); ++iter)
 	{
-		const auto& fileOne = **iterOne;
+		const auto& file = **iter;
 
-		for (auto iterTwo = iterOne + 1; iterTwo != plotFiles.end(); ++iterTwo)
+		if (iter != plotFiles.begin() && (*(iter - 1))->getAccountId() != file.getAccountId())
+			open.clear();
+
+		open.erase(std::remove_if(open.begin(), open.end(), [&file](const PlotFile* previous)
 		{
-			const auto& fileTwo = **iterTwo;
+			return previous->getNonceStart() + previous->getNonces() <= file.getNonceStart();
+		}), open.end());
 
-			if (fileOne.getPath() != fileTwo.getPath() && fileOne.getAccountId() == fileTwo.getAccountId())
-			{
-				if (fileTwo.getNonceStart() >= fileOne.getNonceStart() && fileTwo.getNonceStart() < fileOne.getNonceStart() + fileOne.getNonces())
-				{
-					auto overlap = fileOne.getNonceStart() + fileOne.getNonces() - fileTwo.getNonceStart();
-					if (fileTwo.getNonces() < overlap)
-						overlap = fileTwo.getNonces();
-					log_error(MinerLogger::miner, "%s and %s overlap by %s nonces.", fileOne.getPath(), fileTwo.getPath(), std::to_string(overlap));
-					++totalOverlaps;
-				}
-				else if (fileOne.getNonceStart() >= fileTwo.getNonceStart() && fileOne.getNonceStart() < fileTwo.getNonceStart() + fileTwo.getNonces())
-				{
-					auto overlap = fileTwo.getNonceStart() + fileTwo.getNonces() - fileOne.getNonceStart();
-					if (fileOne.getNonces() < overlap)
-						overlap = fileOne.getNonces();
-					log_error(MinerLogger::miner, "%s and %s overlap by %s nonces.", fileTwo.getPath(), fileOne.getPath(), std::to_string(overlap));
-					++totalOverlaps;
-				}
-			}
+		for (const auto previous : open)
+		{
+			if (previous->getPath() == file.getPath())
+				continue;
+
+			const auto overlap = std::min(previous->getNonceStart() + previous->getNonces(),
+			                              file.getNonceStart() + file.getNonces()) - file.getNonceStart();
+			log_error(MinerLogger::miner, "%s and %s overlap by %s nonces.", previous->getPath(), file.getPath(), std::to_string(overlap));
+			++totalOverlaps;
 		}
+
+		open.emplace_back(&file);
 	}
+
 	if (totalOverlaps > 0)
 	{
 		log_error(MinerLogger::miner, "Total overlaps found: " + std::to_string(totalOverlaps));
 	}
 	else
 		log_system(MinerLogger::config, "No overlaps found.");
+
+	log_debug(MinerLogger::config, "Checked %z plot files for overlaps in %ss", plotFiles.size(),
+	          Poco::NumberFormatter::format(static_cast<double>(timeStart.elapsed()) / 1000000, 3));
 }
 
 void Burst::MinerConfig::printConsole() const
@@ -273,7 +314,274 @@ void Burst::MinerConfig::recalculatePlotsHash()
 	PlotSizes::set(Poco::Net::IPAddress{"127.0.0.1"}, getTotalPlotsize(), true);
 }
 
-Burst::ReadConfigFileResult Burst::MinerConfig::readConfigFile(const std::string& configPath)
+std::vector<std::shared_ptr<Burst::PlotDir>> Burst::MinerConfig::scanPlotDirs(Poco::JSON::Object::Ptr miningObj,
+                                                                               const std::vector<std::shared_ptr<PlotDir>>& previousPlotDirs)
+{
+	std::vector<std::shared_ptr<PlotDir>> plotDirs;
+	Poco::Timestamp timeStartScan;
+
+	try
+	{
+		const Poco::JSON::Array::Ptr arr(new Poco::JSON::Array);
+		auto plotsArr = getOrAddExtract(miningObj, "plots", arr);
+
+		auto plotsDyn = miningObj->get("plots");
+
+		// the plot dirs are scanned by one task per device, so the devices are validated in parallel,
+		// but no device is seeked by more than one task at a time
+		struct PlotDirScan
+		{
+			std::string path;
+			std::vector<std::string> relatedPaths;
+			PlotDir::Type type;
+			bool unique;
+			std::shared_ptr<PlotDir> plotDir;
+			std::exception_ptr error;
+			std::vector<std::shared_ptr<PlotDir>> relatedDirs;
+			std::vector<std::exception_ptr> relatedErrors;
+		};
+
+		std::vector<PlotDirScan> scans;
+		size_t reused = 0;
+
+		const auto scan = [&scans, &previousPlotDirs, &reused](const std::string& path, const std::vector<std::string>& relatedPaths,
+		                                                      const PlotDir::Type type, const bool unique)
+		{
+			const auto previous = std::find_if(previousPlotDirs.begin(), previousPlotDirs.end(),
+				[&](const std::shared_ptr<PlotDir>& plotDir)
+				{
+					const auto relatedDirs = plotDir->getRelatedDirs();
+
+					return plotDir->getPath() == path && plotDir->getType() == type &&
+						std::equal(relatedDirs.begin(), relatedDirs.end(), relatedPaths.begin(), relatedPaths.end(),
+						           [](const std::shared_ptr<PlotDir>& relatedDir, const std::string& relatedPath)
+						           {
+							           return relatedDir->getPath() == relatedPath;
+						           });
+				});
+
+			PlotDirScan plotDirScan{path, relatedPaths, type, unique, nullptr, nullptr,
+			                        std::vector<std::shared_ptr<PlotDir>>(relatedPaths.size()),
+			                        std::vector<std::exception_ptr>(relatedPaths.size())};
+
+			if (previous != previousPlotDirs.end())
+			{
+				plotDirScan.plotDir = *previous;
+				++reused;
+			}
+
+			scans.emplace_back(std::move(plotDirScan));
+		};
+
+		if (plotsDyn.type() == typeid(Poco::JSON::Array::Ptr))
+		{
+			auto plots = plotsDyn.extract<Poco::JSON::Array::Ptr>();
+
+			for (auto& plot : *plots)
+			{
+				try
+				{
+					// string means sequential plot dir
+					if (plot.isString())
+						scan(plot.extract<std::string>(), {}, PlotDir::Type::Sequential, true);
+					// object means custom (sequential/parallel) plot dir
+					else if (plot.type() == typeid(Poco::JSON::Object::Ptr))
+					{
+						const auto sequential = "sequential";
+						const auto parallel = "parallel";
+
+						auto plotJson = plot.extract<Poco::JSON::Object::Ptr>();
+						auto type = PlotDir::Type::Sequential;
+
+						auto typeStr = plotJson->optValue<std::string>("type", "");
+
+						auto path = plotJson->get("path");
+
+						if (path.isEmpty())
+							log_error(MinerLogger::config, "Empty dir given as plot dir/file! Skipping it...");
+						else if (typeStr.empty())
+							log_error(MinerLogger::config, "Invalid type of plot dir/file %s! Skipping it...", path.toString());
+						else if (typeStr != sequential && typeStr != parallel)
+							log_error(MinerLogger::config, "Type of plot dir/file %s is invalid (%s)! Skipping it...", path.toString(), typeStr);
+						else
+						{
+							if (typeStr == sequential)
+								type = PlotDir::Type::Sequential;
+							else if (typeStr == parallel)
+								type = PlotDir::Type::Parallel;
+
+							// related dirs
+							if (path.type() == typeid(Poco::JSON::Array::Ptr))
+							{
+								auto relatedPathsJson = path.extract<Poco::JSON::Array::Ptr>();
+								std::vector<std::string> relatedPaths;
+
+								for (const auto& relatedPath : *relatedPathsJson)
+								{
+									if (relatedPath.isString())
+										relatedPaths.emplace_back(relatedPath.extract<std::string>());
+									else
+										log_error(MinerLogger::config, "Invalid plot dir/file %s! Skipping it...", relatedPath.toString());
+								}
+
+								if (!relatedPaths.empty())
+									scan(*relatedPaths.begin(), { relatedPaths.begin() + 1, relatedPaths.end() }, type, false);
+							}
+							// single dir
+							else if (path.isString())
+								scan(path.toString(), {}, type, false);
+							else
+								log_error(MinerLogger::config, "Invalid plot dir/file %s! Skipping it...", path.toString());
+						}
+					}
+				}
+				catch (const Poco::Exception& e)
+				{
+					log_warning(MinerLogger::config, "Error while adding the plotdir/file: %s", e.message());
+				}
+			}
+		}
+
+		// every dir (also a related one) is scanned by the task of its device,
+		// there are not more tasks than cores, so some tasks scan more than one device
+		std::map<std::string, std::vector<std::pair<size_t, size_t>>> devices;
+
+		for (size_t i = 0; i < scans.size(); ++i)
+		{
+			if (scans[i].plotDir != nullptr)
+				continue;
+
+			devices[getDeviceOfPath(scans[i].path)].emplace_back(i, 0);
+
+			for (size_t j = 0; j < scans[i].relatedPaths.size(); ++j)
+				devices[getDeviceOfPath(scans[i].relatedPaths[j])].emplace_back(i, j + 1);
+		}
+
+		const auto taskCount = std::min<size_t>(devices.size(), std::max(1u, std::thread::hardware_concurrency()));
+		std::vector<std::vector<std::pair<size_t, size_t>>> taskDirs(taskCount);
+		size_t deviceIndex = 0;
+
+		for (const auto& device : devices)
+		{
+			auto& dirs = taskDirs[deviceIndex++ % taskCount];
+			dirs.insert(dirs.end(), device.second.begin(), device.second.end());
+		}
+
+		std::vector<std::future<void>> tasks;
+
+		for (const auto& dirs : taskDirs)
+			tasks.emplace_back(std::async(std::launch::async, [&scans, &dirs]()
+			{
+				for (const auto& dir : dirs)
+				{
+					auto& plotDirScan = scans[dir.first];
+
+					// every dir has its own slot, so the tasks never write the same one
+					if (dir.second == 0)
+					{
+						try
+						{
+							plotDirScan.plotDir = std::make_shared<PlotDir>(plotDirScan.path, plotDirScan.type);
+						}
+						catch (...)
+						{
+							plotDirScan.error = std::current_exception();
+						}
+					}
+					else
+					{
+						const auto related = dir.second - 1;
+
+						try
+						{
+							plotDirScan.relatedDirs[related] = std::make_shared<PlotDir>(plotDirScan.relatedPaths[related],
+							                                                             plotDirScan.type);
+						}
+						catch (...)
+						{
+							plotDirScan.relatedErrors[related] = std::current_exception();
+						}
+					}
+				}
+			}));
+
+		for (auto& task : tasks)
+			task.wait();
+
+		// collect the scanned plot dirs in the order of the configuration
+		for (auto& plotDirScan : scans)
+		{
+			try
+			{
+				if (plotDirScan.error != nullptr)
+					std::rethrow_exception(plotDirScan.error);
+
+				for (const auto& relatedError : plotDirScan.relatedErrors)
+					if (relatedError != nullptr)
+						std::rethrow_exception(relatedError);
+
+				auto plotDir = plotDirScan.plotDir;
+
+				for (auto& relatedDir : plotDirScan.relatedDirs)
+					if (relatedDir != nullptr)
+						plotDir->addRelatedDir(relatedDir);
+
+				// same plotdir already in collection
+				if (plotDirScan.unique &&
+					std::any_of(plotDirs.begin(), plotDirs.end(), [&](const std::shared_ptr<PlotDir>& element)
+					{
+						return element->getPath() == plotDir->getPath() ||
+							element->getHash() == plotDir->getHash();
+					}))
+					throw Poco::Exception{Poco::format("The plotfile/dir %s already exists!", plotDir->getPath())};
+
+				plotDirs.emplace_back(plotDir);
+			}
+			catch (const Poco::Exception& e)
+			{
+				log_warning(MinerLogger::config, "Error while adding the plotdir/file %s: %s", plotDirScan.path, e.message());
+			}
+		}
+
+		size_t plotFiles = 0;
+
+		for (const auto& plotDir : plotDirs)
+			plotFiles += plotDir->getPlotfiles(true).size();
+
+		log_system(MinerLogger::config, "Scanned %z plot dirs (%z kept) with %z plot files in %ss",
+		           scans.size(), reused, plotFiles,
+		           Poco::NumberFormatter::format(static_cast<double>(timeStartScan.elapsed()) / 1000000, 3));
+		/*else if (plotsDyn.isString())
+		{
+			addPlotLocation(plotsDyn.extract<std::string>());
+		}
+		else if (plotsDyn.isEmpty())
+		{
+			Poco::JSON::Array::Ptr arr = new Poco::JSON::Array;
+			config->set("plots", arr);
+		}
+		else
+		{
+			log_warning(MinerLogger::config, "Invalid plot file or directory in config file %s\n%s",
+				configPath, plotsDyn.toString());
+		}*/
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_error(MinerLogger::config,
+			"Error while reading plot files!\n"
+			"%s",
+			exc.displayText()
+		);
+
+		log_current_stackframe(MinerLogger::config);
+	}
+
+
+	return plotDirs;
+}
+
+Burst::ReadConfigFileResult Burst::MinerConfig::readConfigFile(const std::string& configPath, const bool keepPlotIndex)
 {
 	poco_ndc(readConfigFile);
 	std::ifstream inputFileStream;
@@ -292,9 +600,6 @@ Burst::ReadConfigFileResult Burst::MinerConfig::readConfigFile(const std::string
 	if (!inputFileStream.is_open())
 		return ReadConfigFileResult::NotFound;
 
-	configPath_ = configPath;
-	plotDirs_.clear();
-
 	Poco::JSON::Parser parser;
 	Poco::JSON::Object::Ptr config;
 	std::stringstream jsonValidationStream;
@@ -363,6 +668,39 @@ Burst::ReadConfigFileResult Burst::MinerConfig::readConfigFile(const std::string
 		return ReadConfigFileResult::Invalid;
 	}
 
+	Poco::JSON::Object::Ptr miningObj;
+
+	if (config->has("mining"))
+		miningObj = config->get("mining").extract<Poco::JSON::Object::Ptr>();
+	else
+		miningObj.assign(new Poco::JSON::Object);
+
+	// the plot dirs of the last read, an unchanged one can be taken over without scanning it again
+	std::vector<std::shared_ptr<PlotDir>> previousPlotDirs;
+
+	if (keepPlotIndex)
+	{
+		Poco::Mutex::ScopedLock lock(mutex_);
+		previousPlotDirs = plotDirs_;
+	}
+
+	// the scan can take a while, so it is done before the settings are locked;
+	// the previous plot dirs stay in use until they are swapped
+	auto plotDirs = scanPlotDirs(miningObj, previousPlotDirs);
+
+	// all settings are applied in one locked section, so a reread while mining is never seen half done;
+	// the setters do not publish the half applied settings, they are published once at the end
+	Poco::Mutex::ScopedLock lock(mutex_);
+	publishingDeferred_ = true;
+
+	struct PublishingGuard
+	{
+		bool& deferred;
+		~PublishingGuard() { deferred = false; }
+	} publishingGuard{publishingDeferred_};
+
+	configPath_ = configPath;
+
 	const auto checkCreateUrlFunc = [](Poco::JSON::Object::Ptr urlsObj, const std::string& name, Url& url,
 		const std::string& defaultScheme, unsigned short defaultPort, const std::string& createUrl, bool forceInsert = false)
 	{
@@ -407,6 +745,10 @@ Burst::ReadConfigFileResult Burst::MinerConfig::readConfigFile(const std::string
 
 			logUseColors_ = getOrAdd(loggingObj, "useColors", true);
 			verboseLogging_ = getOrAdd(loggingObj, "verbose", true);
+			asyncLogging_ = getOrAdd(loggingObj, "async", true);
+			logOverflowPolicy_ = getOrAdd(loggingObj, "asyncOverflow", std::string("block")) == "drop"
+				                     ? LogOverflowPolicy::Drop
+				                     : LogOverflowPolicy::Block;
 
 			Poco::JSON::Object::Ptr progressBarObj = nullptr;
 
@@ -454,6 +796,8 @@ Burst::ReadConfigFileResult Burst::MinerConfig::readConfigFile(const std::string
 			loggingObj->set("outputType", std::string("terminal"));
 
 			loggingObj->set("useColors", true);
+			loggingObj->set("async", true);
+			loggingObj->set("asyncOverflow", std::string("block"));
 
 			// progress bar
 			{
@@ -469,6 +813,14 @@ Burst::ReadConfigFileResult Burst::MinerConfig::readConfigFile(const std::string
 			config->set("logging", loggingObj);
 		}
 
+		// the console, the logfile and the websockets are written by the message dispatcher
+		Message::setOverflowPolicy(logOverflowPolicy_);
+
+		if (asyncLogging_)
+			Message::startDispatcher();
+		else
+			Message::stopDispatcher();
+
 		// output
 		{
 			Poco::JSON::Object::Ptr outputObj;
@@ -488,13 +840,6 @@ Burst::ReadConfigFileResult Burst::MinerConfig::readConfigFile(const std::string
 
 	// mining
 	{
-		Poco::JSON::Object::Ptr miningObj;
-
-		if (config->has("mining"))
-			miningObj = config->get("mining").extract<Poco::JSON::Object::Ptr>();
-		else
-			miningObj.assign(new Poco::JSON::Object);
-
 		submissionMaxRetry_ = getOrAdd(miningObj, "submissionMaxRetry", 10);
 		maxBufferSizeMb_ = getOrAdd(miningObj, "maxBufferSizeMB", 0u);
 
@@ -506,6 +851,7 @@ Burst::ReadConfigFileResult Burst::MinerConfig::readConfigFile(const std::string
 
 		walletRequestTries_ = getOrAdd(miningObj, "walletRequestTries", 5);
 		walletRequestRetryWaitTime_ = getOrAdd(miningObj, "walletRequestRetryWaitTime", 3);
+		accountCacheTtl_ = getOrAdd(miningObj, "accountCacheTtl", 3600);
 
 		// use insecure plotfiles
 		useInsecurePlotfiles_ = getOrAdd(miningObj, "useInsecurePlotfiles", false);
@@ -519,6 +865,8 @@ Burst::ReadConfigFileResult Burst::MinerConfig::readConfigFile(const std::string
 		cpuInstructionSet_ = Poco::trim(cpuInstructionSet_);
 
 		databasePath_ = getOrAdd(miningObj, "databasePath", std::string("data.db"));
+		// 0 keeps the raw history forever
+		historyRetentionDays_ = getOrAdd(miningObj, "historyRetentionDays", 0u);
 		workerName_ = getOrAdd(miningObj, "workerName", std::string{});
 		poc2StartBlock_ = getOrAdd(miningObj, "poc2StartBlock", 502000);
 
@@ -674,114 +1022,11 @@ Burst::ReadConfigFileResult Burst::MinerConfig::readConfigFile(const std::string
 			miningObj->set("urls", urlsObj);
 		}
 
-		// plots
-		{
-			try
-			{
-				const Poco::JSON::Array::Ptr arr(new Poco::JSON::Array);
-				auto plotsArr = getOrAddExtract(miningObj, "plots", arr);
-
-				auto plotsDyn = miningObj->get("plots");
-
-				if (plotsDyn.type() == typeid(Poco::JSON::Array::Ptr))
-				{
-					auto plots = plotsDyn.extract<Poco::JSON::Array::Ptr>();
-
-					for (auto& plot : *plots)
-					{
-						try
-						{
-							// string means sequential plot dir
-							if (plot.isString())
-								addPlotDir(std::make_shared<PlotDir>(plot.extract<std::string>(), PlotDir::Type::Sequential));
-							// object means custom (sequential/parallel) plot dir
-							else if (plot.type() == typeid(Poco::JSON::Object::Ptr))
-							{
-								const auto sequential = "sequential";
-								const auto parallel = "parallel";
-
-								auto plotJson = plot.extract<Poco::JSON::Object::Ptr>();
-								auto type = PlotDir::Type::Sequential;
+		// plots, they were scanned before the settings were locked
+		plotDirs_.swap(plotDirs);
 
-								auto typeStr = plotJson->optValue<std::string>("type", "");
-
-								auto path = plotJson->get("path");
-
-								if (path.isEmpty())
-									log_error(MinerLogger::config, "Empty dir given as plot dir/file! Skipping it...");
-								else if (typeStr.empty())
-									log_error(MinerLogger::config, "Invalid type of plot dir/file %s! Skipping it...", path.toString());
-								else if (typeStr != sequential && typeStr != parallel)
-									log_error(MinerLogger::config, "Type of plot dir/file %s is invalid (%s)! Skipping it...", path.toString(), typeStr);
-								else
-								{
-									if (typeStr == sequential)
-										type = PlotDir::Type::Sequential;
-									else if (typeStr == parallel)
-										type = PlotDir::Type::Parallel;
-
-									// related dirs
-									if (path.type() == typeid(Poco::JSON::Array::Ptr))
-									{
-										auto relatedPathsJson = path.extract<Poco::JSON::Array::Ptr>();
-										std::vector<std::string> relatedPaths;
-
-										for (const auto& relatedPath : *relatedPathsJson)
-										{
-											if (relatedPath.isString())
-												relatedPaths.emplace_back(relatedPath.extract<std::string>());
-											else
-												log_error(MinerLogger::config, "Invalid plot dir/file %s! Skipping it...", relatedPath.toString());
-										}
-
-										if (relatedPaths.size() == 1)
-											plotDirs_.emplace_back(new PlotDir{ *relatedPaths.begin(), type });
-										else if (relatedPaths.size() > 1)
-											plotDirs_.emplace_back(new PlotDir{ *relatedPaths.begin(), { relatedPaths.begin() + 1, relatedPaths.end() }, type });
-									}
-									// single dir
-									else if (path.isString())
-										plotDirs_.emplace_back(new PlotDir{ path, type });
-									else
-										log_error(MinerLogger::config, "Invalid plot dir/file %s! Skipping it...", path.toString());
-								}
-							}
-						}
-						catch (const Poco::Exception& e)
-						{
-							log_warning(MinerLogger::config, "Error while adding the plotdir/file: %s", e.message());
-						}
-					}
-				}
-				/*else if (plotsDyn.isString())
-				{
-					addPlotLocation(plotsDyn.extract<std::string>());
-				}
-				else if (plotsDyn.isEmpty())
-				{
-					Poco::JSON::Array::Ptr arr = new Poco::JSON::Array;
-					config->set("plots", arr);
-				}
-				else
-				{
-					log_warning(MinerLogger::config, "Invalid plot file or directory in config file %s\n%s",
-						configPath, plotsDyn.toString());
-				}*/
-			}
-			catch (Poco::Exception& exc)
-			{
-				log_error(MinerLogger::config,
-					"Error while reading plot files!\n"
-					"%s",
-					exc.displayText()
-				);
-
-				log_current_stackframe(MinerLogger::config);
-			}
-
-			// combining all plotfiles to lists of plotfiles on the same device
-			recalculatePlotsHash();
-		}
+		// combining all plotfiles to lists of plotfiles on the same device
+		recalculatePlotsHash();
 
 
 		// max historical data
@@ -1068,6 +1313,9 @@ Burst::ReadConfigFileResult Burst::MinerConfig::readConfigFile(const std::string
 	if (!save(configPath_, *config))
 		log_error(MinerLogger::config, "Could not save new settings!");
 
+	publishingDeferred_ = false;
+	publishSnapshot();
+
 	return ReadConfigFileResult::Ok;
 }
 
@@ -1279,6 +1527,12 @@ const std::string& Burst::MinerConfig::getDatabasePath() const
 	return databasePath_;
 }
 
+unsigned Burst::MinerConfig::getHistoryRetentionDays() const
+{
+	Poco::Mutex::ScopedLock lock(mutex_);
+	return historyRetentionDays_;
+}
+
 const std::string& Burst::MinerConfig::getWorkerName() const
 {
 	return workerName_;
@@ -1312,6 +1566,58 @@ Poco::UInt64 Burst::MinerConfig::getTargetDeadline(TargetDeadlineType type) cons
 	}
 }
 
+std::shared_ptr<const Burst::ConfigSnapshot> Burst::MinerConfig::getSnapshot() const
+{
+	return std::atomic_load(&snapshot_);
+}
+
+void Burst::MinerConfig::publishSnapshot()
+{
+	Poco::Mutex::ScopedLock lock(mutex_);
+
+	if (publishingDeferred_)
+		return;
+
+	auto snapshot = std::make_shared<ConfigSnapshot>();
+
+	snapshot->version = getSnapshot()->version + 1;
+	snapshot->maxBufferSize = getMaxBufferSize();
+	snapshot->maxBufferSizeRaw = maxBufferSizeMb_;
+	snapshot->bufferChunkCount = bufferChunkCount_;
+	snapshot->chunkBytes = bufferChunkCount_ > 0 ? snapshot->maxBufferSize / bufferChunkCount_ : snapshot->maxBufferSize;
+	snapshot->targetDeadlineLocal = targetDeadline_;
+	snapshot->targetDeadlinePool = targetDeadlinePool_;
+	snapshot->targetDeadlineCombined = getTargetDeadline(TargetDeadlineType::Combined);
+	snapshot->poc2StartBlock = poc2StartBlock_;
+	snapshot->submitProbability = submitProbability_;
+	snapshot->targetDlFactor = targetDlFactor_;
+	snapshot->verboseLogging = verboseLogging_;
+	snapshot->processorType = processorType_;
+	snapshot->cpuInstructionSet = cpuInstructionSet_;
+
+	std::atomic_store(&snapshot_, std::shared_ptr<const ConfigSnapshot>(std::move(snapshot)));
+}
+
+Poco::UInt64 Burst::ConfigSnapshot::getTargetDeadline(TargetDeadlineType type) const
+{
+	switch (type)
+	{
+	case TargetDeadlineType::Pool:
+		return targetDeadlinePool;
+	case TargetDeadlineType::Local:
+		return targetDeadlineLocal;
+	case TargetDeadlineType::Combined:
+		return targetDeadlineCombined;
+	default:
+		return 0;
+	}
+}
+
+bool Burst::ConfigSnapshot::isPoC2(Poco::UInt64 blockheight) const
+{
+	return poc2StartBlock > 0 && poc2StartBlock <= blockheight;
+}
+
 Burst::Url Burst::MinerConfig::getServerUrl() const
 {
 	Poco::Mutex::ScopedLock lock(mutex_);
@@ -1407,11 +1713,11 @@ bool Burst::MinerConfig::forPlotDirs(const std::function<bool(PlotDir&)>& traver
 	return success;
 }
 
-//const std::string& Burst::MinerConfig::getPlotsHash() const
-//{
-//	Poco::Mutex::ScopedLock lock{ mutex_ };
-//	return plotsHash_;
-//}
+std::string Burst::MinerConfig::getPlotsHash() const
+{
+	Poco::Mutex::ScopedLock lock{mutex_};
+	return plotsHash_;
+}
 
 const std::string& Burst::MinerConfig::getPassphrase() const
 {
@@ -1488,6 +1794,7 @@ void Burst::MinerConfig::setBufferSize(Poco::UInt64 bufferSize)
 {
 	Poco::Mutex::ScopedLock lock(mutex_);
 	maxBufferSizeMb_ = bufferSize;
+	publishSnapshot();
 }
 
 void Burst::MinerConfig::setMaxSubmissionRetry(unsigned value)
@@ -1514,6 +1821,8 @@ void Burst::MinerConfig::setMaxHistoricalBlocks(Poco::UInt64 maxHistData)
 
 void Burst::MinerConfig::setSubmitProbability(double subP)
 {
+	Poco::Mutex::ScopedLock lock(mutex_);
+
 	if (subP < 0)
 		submitProbability_ = 0;
 	else if (subP >=0.999999)
@@ -1527,6 +1836,7 @@ void Burst::MinerConfig::setSubmitProbability(double subP)
 		deadlinePerformanceFac_ = 1.0 * 240.0;
 
 	targetDlFactor_ = -log(1.0 - submitProbability_) * 240.0;
+	publishSnapshot();
 }
 
 
@@ -1544,6 +1854,8 @@ void Burst::MinerConfig::setTargetDeadline(Poco::UInt64 target_deadline, TargetD
 		targetDeadline_ = target_deadline;
 	else if (type == TargetDeadlineType::Pool)
 		targetDeadlinePool_ = target_deadline;
+
+	publishSnapshot();
 }
 
 Poco::UInt64 Burst::MinerConfig::getMaxBufferSize() const
@@ -1598,6 +1910,11 @@ unsigned Burst::MinerConfig::getWalletRequestRetryWaitTime() const
 	return walletRequestRetryWaitTime_;
 }
 
+unsigned Burst::MinerConfig::getAccountCacheTtl() const
+{
+	return accountCacheTtl_;
+}
+
 unsigned Burst::MinerConfig::getWakeUpTime() const
 {
 	return wakeUpTime_;
@@ -1663,6 +1980,8 @@ bool Burst::MinerConfig::save(const std::string& path) const
 		logging.set("path", getLogDir());
 		logging.set("logfile", isLogfileUsed());
 		logging.set("useColors", isUsingLogColors());
+		logging.set("async", isAsyncLogging());
+		logging.set("asyncOverflow", std::string(logOverflowPolicy_ == LogOverflowPolicy::Drop ? "drop" : "block"));
 
 		// output type
 		if (logOutputType_ == LogOutputType::Terminal)
@@ -1700,6 +2019,7 @@ bool Burst::MinerConfig::save(const std::string& path) const
 		mining.set("timeout", static_cast<Poco::UInt64>(timeout_));
 		mining.set("walletRequestRetryWaitTime", walletRequestRetryWaitTime_);
 		mining.set("walletRequestTries", walletRequestTries_);
+		mining.set("accountCacheTtl", accountCacheTtl_);
 		mining.set("useInsecurePlotfiles", useInsecurePlotfiles());
 		mining.set("rescanEveryBlock", isRescanningEveryBlock());
 		mining.set("bufferChunkCount", getBufferChunkCount());
@@ -1709,6 +2029,7 @@ bool Burst::MinerConfig::save(const std::string& path) const
 		mining.set("gpuDevice", getGpuDevice());
 		mining.set("gpuPlatform", getGpuPlatform());
 		mining.set("databasePath", getDatabasePath());
+		mining.set("historyRetentionDays", getHistoryRetentionDays());
 		mining.set("workerName", getWorkerName());
 
 		// passphrase
@@ -1866,6 +2187,8 @@ bool Burst::MinerConfig::addPlotDir(std::shared_ptr<PlotDir> plotDir)
 		throw Poco::Exception{Poco::format("The plotfile/dir %s already exists!", plotDir->getPath())};
 
 	plotDirs_.emplace_back(plotDir);
+	publishSnapshot();
+	recalculatePlotsHash();
 	return true;
 }
 
@@ -1905,24 +2228,28 @@ void Burst::MinerConfig::setBufferChunkCount(unsigned bufferChunkCount)
 {
 	Poco::Mutex::ScopedLock lock(mutex_);
 	bufferChunkCount_ = bufferChunkCount;
+	publishSnapshot();
 }
 
 void Burst::MinerConfig::setPoolTargetDeadline(Poco::UInt64 targetDeadline)
 {
 	Poco::Mutex::ScopedLock lock(mutex_);
 	targetDeadlinePool_ = targetDeadline;
+	publishSnapshot();
 }
 
 void Burst::MinerConfig::setProcessorType(const std::string& processorType)
 {
 	Poco::Mutex::ScopedLock lock(mutex_);
 	processorType_ = processorType;
+	publishSnapshot();
 }
 
 void Burst::MinerConfig::setCpuInstructionSet(const std::string& instructionSet)
 {
 	Poco::Mutex::ScopedLock lock(mutex_);
 	cpuInstructionSet_ = instructionSet;
+	publishSnapshot();
 }
 
 void Burst::MinerConfig::setGpuPlatform(const unsigned platformIndex)
@@ -2007,6 +2334,8 @@ bool Burst::MinerConfig::removePlotDir(const std::string& dir)
 		throw Poco::Exception{Poco::format("The plot dir '%s' does not exist", dir)};
 
 	plotDirs_.erase(iter);
+	publishSnapshot();
+	recalculatePlotsHash();
 	return true;
 }
 
@@ -2180,6 +2509,16 @@ bool Burst::MinerConfig::isUsingLogColors() const
 	return logUseColors_;
 }
 
+bool Burst::MinerConfig::isAsyncLogging() const
+{
+	return asyncLogging_;
+}
+
+Burst::LogOverflowPolicy Burst::MinerConfig::getLogOverflowPolicy() const
+{
+	return logOverflowPolicy_;
+}
+
 bool Burst::MinerConfig::isSteadyProgressBar() const
 {
 	return steadyProgressBar_;
@@ -30,6 +30,7 @@
 #include <functional>
 #include "Declarations.hpp"
 #include <chrono>
+#include "logging/Message.hpp"
 
 namespace Poco
 {
@@ -105,12 +106,43 @@ namespace Burst
 		Invalid,
 		Error
 	};
-	
+
+	/**
+	 * \brief An immutable copy of the settings that are read on the hot paths.
+	 * A new snapshot is published every time one of the settings changes, so a reader
+	 * can hold on to one snapshot for a whole round without locking the configuration.
+	 */
+	struct ConfigSnapshot
+	{
+		Poco::UInt64 version = 0;
+		Poco::UInt64 maxBufferSize = 0;
+		Poco::UInt64 maxBufferSizeRaw = 0;
+		unsigned bufferChunkCount = 16;
+		Poco::UInt64 chunkBytes = 0;
+		Poco::UInt64 targetDeadlineLocal = 0, targetDeadlinePool = 0, targetDeadlineCombined = 0;
+		Poco::UInt64 poc2StartBlock = 0;
+		double submitProbability = 0.999;
+		double targetDlFactor = 1.0;
+		bool verboseLogging = false;
+		std::string processorType = "CPU";
+		std::string cpuInstructionSet = "AUTO";
+
+		Poco::UInt64 getTargetDeadline(TargetDeadlineType type = TargetDeadlineType::Combined) const;
+		bool isPoC2(Poco::UInt64 blockheight) const;
+	};
+
 	class MinerConfig
 	{
 	public:
 		void recalculatePlotsHash();
-		ReadConfigFileResult readConfigFile(const std::string& configPath);
+		/**
+		 * \brief Reads the settings from a configuration file.
+		 * \param configPath The path to the configuration file.
+		 * \param keepPlotIndex If true, the plot dirs that are configured like before are
+		 * taken over with their plot files instead of scanning them again.
+		 * \return The result of the read.
+		 */
+		ReadConfigFileResult readConfigFile(const std::string& configPath, bool keepPlotIndex = false);
 		void rescan();
 
 		/**
@@ -181,6 +213,7 @@ namespace Burst
 		const std::string& getServerCertificatePath() const;
 		const std::string& getServerCertificatePass() const;
 		const std::string& getDatabasePath() const;
+		unsigned getHistoryRetentionDays() const;
 		const std::string& getWorkerName() const;
 
 		Url getServerUrl() const;
@@ -190,7 +223,10 @@ namespace Burst
 		Poco::UInt64 getTargetDeadline(TargetDeadlineType type = TargetDeadlineType::Combined) const;
 		unsigned getMiningIntensity(bool real = true) const;
 		bool forPlotDirs(const std::function<bool(PlotDir&)>& traverseFunction) const;
-		//const std::string& getPlotsHash() const;
+		/**
+		 * \brief A hash over the paths of all plot files, it changes when plot files are added or removed.
+		 */
+		std::string getPlotsHash() const;
 		const std::string& getPassphrase() const;
 		bool useInsecurePlotfiles() const;
 		bool isLogfileUsed() const;
@@ -198,6 +234,8 @@ namespace Burst
 		bool isRescanningEveryBlock() const;
 		LogOutputType getLogOutputType() const;
 		bool isUsingLogColors() const;
+		bool isAsyncLogging() const;
+		LogOverflowPolicy getLogOverflowPolicy() const;
 		bool isSteadyProgressBar() const;
 		bool isFancyProgressBar() const;
 		unsigned getBufferChunkCount() const;
@@ -216,6 +254,12 @@ namespace Burst
 		const Passphrase& getServerPass() const;
 		unsigned getWalletRequestTries() const;
 		unsigned getWalletRequestRetryWaitTime() const;
+
+		/**
+		 * \brief The time in seconds, the cached names, reward recipients and won blocks
+		 * of the own accounts are valid, before they are fetched from the wallet again.
+		 */
+		unsigned getAccountCacheTtl() const;
 		unsigned getWakeUpTime() const;
 		const std::string& getCpuInstructionSet() const;
 		const std::string& getProcessorType() const;
@@ -281,11 +325,34 @@ namespace Burst
 		 */
 		static MinerConfig& getConfig();
 
+		/**
+		 * \brief Returns the currently published snapshot of the hot path settings.
+		 * Does not lock the configuration.
+		 * \return The current snapshot, never nullptr.
+		 */
+		std::shared_ptr<const ConfigSnapshot> getSnapshot() const;
+
 	private:
 		static Poco::JSON::Object::Ptr readOutput(Poco::JSON::Object::Ptr json);
 
+		/**
+		 * \brief Scans the plot dirs of the mining settings, without locking the settings.
+		 * \param miningObj The mining settings, an empty list of plots is added if there is none.
+		 * \param previousPlotDirs The plot dirs of the last read, the unchanged ones are taken over without scanning them.
+		 * \return The plot dirs in the order of the configuration.
+		 */
+		static std::vector<std::shared_ptr<PlotDir>> scanPlotDirs(Poco::JSON::Object::Ptr miningObj,
+		                                                          const std::vector<std::shared_ptr<PlotDir>>& previousPlotDirs);
+
+		/**
+		 * \brief Builds a new snapshot out of the current settings and publishes it.
+		 */
+		void publishSnapshot();
+
 		std::string configPath_;
 		std::vector<std::shared_ptr<PlotDir>> plotDirs_;
+		// set while the configuration file is applied, the snapshot is published once at the end
+		bool publishingDeferred_ = false;
 		float timeout_ = 45.f;
 		unsigned sendMaxRetry_ = 3;
 		unsigned receiveMaxRetry_ = 3;
@@ -316,6 +383,7 @@ namespace Burst
 		unsigned bufferChunkCount_ = 16;
 		unsigned walletRequestTries_ = 3;
 		unsigned walletRequestRetryWaitTime_ = 3;
+		unsigned accountCacheTtl_ = 3600;
 		Passphrase passphrase_ = {};
 		bool useInsecurePlotfiles_ = false;
 		bool logfile_ = false;
@@ -323,6 +391,8 @@ namespace Burst
 		bool rescanEveryBlock_ = false;
 		LogOutputType logOutputType_ = LogOutputType::Terminal;
 		bool logUseColors_ = true;
+		bool asyncLogging_ = true;
+		LogOverflowPolicy logOverflowPolicy_ = LogOverflowPolicy::Block;
 		bool steadyProgressBar_ = true;
 		bool fancyProgressBar_ = true;
 		unsigned wakeUpTime_ = 0;
@@ -337,9 +407,11 @@ namespace Burst
 		std::string serverCertificatePath_;
 		std::string serverCertificatePass_;
 		std::string databasePath_;
+		unsigned historyRetentionDays_ = 0;
 		std::string workerName_;
 		Poco::UInt64 poc2StartBlock_ = 0;
 		bool verboseLogging_ = false;
+		std::shared_ptr<const ConfigSnapshot> snapshot_ = std::make_shared<ConfigSnapshot>();
 		mutable Poco::Mutex mutex_;
 	};
 }
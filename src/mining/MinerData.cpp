@@ -27,6 +27,8 @@
 #include "MinerUtil.hpp"
 #include "wallet/Wallet.hpp"
 #include "wallet/Account.hpp"
+#include <limits>
+#include <algorithm>
 
 using namespace Poco::Data::Keywords;
 
@@ -36,15 +38,13 @@ Burst::BlockData::BlockData(const Poco::UInt64 blockHeight, const Poco::UInt64 b
 	  baseTarget_ {baseTarget},
 	  blockTargetDeadline_{ blockTargetDeadline },
 	  genSigStr_ {genSigStr},
+	  bestDeadlineValue_{std::numeric_limits<Poco::UInt64>::max()},
 	  parent_{parent}
 {
 	poco_ndc(BlockData::BlockData);
 
 	try
 	{
-		entries_ = std::make_shared<std::vector<Poco::JSON::Object>>();
-		//deadlines_ = std::make_shared<std::unordered_map<AccountId, Deadlines>>();
-
 		for (auto i = 0; i < 32; ++i)
 		{
 			const auto byteStr = genSigStr.substr(i * 2, 2);
@@ -69,26 +69,47 @@ Burst::BlockData::BlockData(const Poco::UInt64 blockHeight, const Poco::UInt64 b
 	}
 }
 
-bool Burst::BlockData::addDeadlineUnlocked(std::shared_ptr<Deadline> deadline)
+Burst::BlockData::DeadlineShard& Burst::BlockData::getShard(const AccountId accountId)
 {
-	poco_ndc(BlockData::BlockData);
+	return deadlineShards_[accountId % deadlineShardCount];
+}
+
+const Burst::BlockData::DeadlineShard& Burst::BlockData::getShard(const AccountId accountId) const
+{
+	return deadlineShards_[accountId % deadlineShardCount];
+}
+
+std::vector<std::shared_ptr<Burst::Deadlines>> Burst::BlockData::getAllDeadlines() const
+{
+	std::vector<std::shared_ptr<Deadlines>> allDeadlines;
+
+	for (const auto& shard : deadlineShards_)
+	{
+		Poco::ScopedLock<Poco::FastMutex> lock{shard.mutex};
+
+		for (const auto& accountDeadlines : shard.deadlines)
+			if (accountDeadlines.second != nullptr)
+				allDeadlines.emplace_back(accountDeadlines.second);
+	}
+
+	return allDeadlines;
+}
+
+bool Burst::BlockData::addDeadline(std::shared_ptr<Deadline> deadline)
+{
+	poco_ndc(BlockData::addDeadline);
 
 	try
 	{
-		auto accountId = deadline->getAccountId();
-		
-		auto iter = deadlines_.find(accountId);
+		auto& shard = getShard(deadline->getAccountId());
+		Poco::ScopedLock<Poco::FastMutex> lock{shard.mutex};
 
-		if (iter == deadlines_.end())
-		{
-			deadlines_.insert(std::make_pair(accountId, std::make_shared<Deadlines>(this)));
-			deadlines_[accountId]->add(std::move(deadline));
-		}
-		else
-		{
-			iter->second->add(std::move(deadline));
-		}
+		auto& accountDeadlines = shard.deadlines[deadline->getAccountId()];
+
+		if (accountDeadlines == nullptr)
+			accountDeadlines = std::make_shared<Deadlines>(this);
 
+		accountDeadlines->add(std::move(deadline));
 		return true;
 	}
 	catch (const Poco::Exception& e)
@@ -99,12 +120,6 @@ bool Burst::BlockData::addDeadlineUnlocked(std::shared_ptr<Deadline> deadline)
 	}
 }
 
-bool Burst::BlockData::addDeadline(std::shared_ptr<Deadline> deadline)
-{
-	Poco::ScopedLock<Poco::Mutex> lock{mutex_};
-	return addDeadlineUnlocked(std::move(deadline));
-}
-
 void Burst::BlockData::setBaseTarget(Poco::UInt64 baseTarget)
 {
 	baseTarget_ = baseTarget;
@@ -116,14 +131,26 @@ void Burst::BlockData::confirmedDeadlineEvent(const std::shared_ptr<Deadline>& d
 		return;
 
 	addBlockEntry(createJsonDeadline(*deadline, "nonce confirmed"));
+	timeline_.recordOnce(RoundTimeline::Stage::SubmissionAck);
 
 	// set the best deadline for this block
+	const auto value = deadline->getDeadline();
+	auto bestValue = bestDeadlineValue_.load();
+
+	while (value < bestValue)
 	{
-		Poco::ScopedLock<Poco::Mutex> lock{mutex_};
+		if (bestDeadlineValue_.compare_exchange_weak(bestValue, value))
+		{
+			// a concurrent and even better deadline may already be published, so we
+			// only replace worse ones
+			auto best = std::atomic_load(&bestDeadline_);
+
+			while ((best == nullptr || best->getDeadline() > value) &&
+				!std::atomic_compare_exchange_weak(&bestDeadline_, &best, deadline))
+			{}
 
-		if (bestDeadline_ == nullptr ||
-			bestDeadline_->getDeadline() > deadline->getDeadline())
-			bestDeadline_ = deadline;
+			break;
+		}
 	}
 }
 
@@ -139,25 +166,27 @@ Burst::BlockData::DataLoader& Burst::BlockData::DataLoader::getInstance()
 	return data_loader;
 }
 
-std::shared_ptr<Burst::Account> Burst::BlockData::DataLoader::runGetLastWinner(const std::tuple<const Wallet&, Accounts&, BlockData&>& args)
+std::shared_ptr<Burst::Account> Burst::BlockData::DataLoader::runGetLastWinner(const std::tuple<std::shared_ptr<const Wallet>, Accounts&, BlockData&>& args)
 {
 	poco_ndc(BlockData::DataLoader::runGetLastWinner);
 
 	try
 	{
-		auto& wallet = std::get<0>(args);
+		const auto& wallet = std::get<0>(args);
 		auto& accounts = std::get<1>(args);
 		auto& blockdata = std::get<2>(args);
 		
 		AccountId lastWinner;
 		const auto lastBlockheight = blockdata.blockHeight_ - 1;
 		
-		if (!wallet.isActive())
+		if (!wallet->isActive())
 			return nullptr;
 
-		if (wallet.getWinnerOfBlock(lastBlockheight, lastWinner))
+		// the winner changes every block, so it is always asked for,
+		// but the name and reward recipient of a winner are kept for the next rounds
+		if (wallet->getWinnerOfBlock(lastBlockheight, lastWinner))
 		{
-			auto winnerAccount = accounts.getAccount(lastWinner, wallet, false);
+			auto winnerAccount = accounts.addAccount(lastWinner, wallet);
 
 			winnerAccount->getOrLoadName().wait();
 			winnerAccount->getOrLoadRewardRecipient().wait();
@@ -168,7 +197,7 @@ std::shared_ptr<Burst::Account> Burst::BlockData::DataLoader::runGetLastWinner(c
 				rewardRecipient = "                   Solo mining";
 			else
 			{
-				auto rewardRecipientAccount = accounts.getAccount(winnerAccount->getRewardRecipient(), wallet, false);
+				auto rewardRecipientAccount = accounts.addAccount(winnerAccount->getRewardRecipient(), wallet);
 				rewardRecipientAccount->getOrLoadName().wait();
 				rewardRecipient = "Pool               " + rewardRecipientAccount->getName();
 			}
@@ -243,6 +272,24 @@ void Burst::BlockData::refreshPlotDirs() const
 	addBlockEntry(createJsonPlotDirsRescan());
 }
 
+void Burst::BlockData::refreshLastRoundTimeline() const
+{
+	poco_ndc(BlockData::refreshLastRoundTimeline);
+
+	if (parent_ == nullptr)
+		return;
+
+	std::shared_ptr<BlockData> lastBlock;
+
+	{
+		Poco::ScopedLock<Poco::Mutex> lock{parent_->mutex_};
+		lastBlock = parent_->lastBlockData_;
+	}
+
+	if (lastBlock != nullptr)
+		addBlockEntry(lastBlock->getTimeline().toJSON(lastBlock->getBlockheight()));
+}
+
 void Burst::BlockData::setProgress(const float progressRead, const float progressVerification, const Poco::UInt64 blockheight)
 {
 	poco_ndc(BlockData::setProgress);
@@ -252,13 +299,11 @@ void Burst::BlockData::setProgress(const float progressRead, const float progres
 		if (blockheight != getBlockheight())
 			return;
 
-		{
-			Poco::ScopedLock<Poco::Mutex> lock{mutex_};
-			jsonProgress_ = new Poco::JSON::Object{createJsonProgress(progressRead, progressVerification)};
-		}
+		Poco::JSON::Object::Ptr json = new Poco::JSON::Object{createJsonProgress(progressRead, progressVerification)};
+		entries_.setProgress(json);
 
 		if (parent_ != nullptr)
-			parent_->blockDataChangedEvent.notify(this, *jsonProgress_);
+			parent_->blockDataChangedEvent.notify(this, *json);
 	}
 	catch (const Poco::Exception& e)
 	{
@@ -276,12 +321,11 @@ void Burst::BlockData::setProgress(const std::string& plotDir, const float progr
 		if (blockheight != getBlockheight())
 			return;
 
-		Poco::ScopedLock<Poco::Mutex> lock{mutex_};
-		auto json = new Poco::JSON::Object{ createJsonProgress(progress, 0.f) };
+		Poco::JSON::Object::Ptr json = new Poco::JSON::Object{ createJsonProgress(progress, 0.f) };
 		json->set("type", "plotdir-progress");
 		json->set("dir", plotDir);
 
-		jsonDirProgress_[plotDir].assign(json);
+		entries_.setDirProgress(plotDir, json);
 
 		if (parent_ != nullptr)
 			parent_->blockDataChangedEvent.notify(this, *json);
@@ -304,10 +348,7 @@ void Burst::BlockData::addBlockEntry(Poco::JSON::Object entry) const
 
 	try
 	{
-		{
-			Poco::ScopedLock<Poco::Mutex> lock{mutex_};
-			entries_->emplace_back(entry);	
-		}
+		entries_.add(entry);
 		
 		if (parent_ != nullptr)
 			parent_->blockDataChangedEvent.notify(this, entry);	
@@ -351,6 +392,7 @@ Poco::UInt64 Burst::BlockData::getBlockTargetDeadline() const
 
 std::shared_ptr<Burst::Account> Burst::BlockData::getLastWinner() const
 {
+	Poco::ScopedLock<Poco::Mutex> lock{mutex_};
 	return lastWinner_;
 }
  
@@ -366,31 +408,20 @@ const std::string& Burst::BlockData::getGensigStr() const
 
 std::shared_ptr<Burst::Deadline> Burst::BlockData::getBestDeadline() const
 {
-	return bestDeadline_;
+	return std::atomic_load(&bestDeadline_);
 }
 
 std::shared_ptr<Burst::Deadline> Burst::BlockData::getBestDeadline(const DeadlineSearchType searchType) const
 {
-	Poco::ScopedLock<Poco::Mutex> lock{mutex_};
 	std::shared_ptr<Deadline> bestDeadline;
 
 	poco_ndc(BlockData::getBestDeadline);
 
 	try
 	{
-		for (const auto& accountDeadlines : deadlines_)
+		for (const auto& accountDeadlines : getAllDeadlines())
 		{
-			if (accountDeadlines.second == nullptr)
-				continue;
-		
-			std::shared_ptr<Deadline> accountBestDeadline;
-
-			if (searchType == DeadlineSearchType::Found)
-				accountBestDeadline = accountDeadlines.second->getBestFound();
-			else if (searchType == DeadlineSearchType::Sent)
-				accountBestDeadline = accountDeadlines.second->getBestSent();
-			else if (searchType == DeadlineSearchType::Confirmed)
-				accountBestDeadline = accountDeadlines.second->getBestConfirmed();
+			const auto accountBestDeadline = getBestOf(*accountDeadlines, searchType);
 
 			if (accountBestDeadline == nullptr)
 				continue;
@@ -412,29 +443,11 @@ std::shared_ptr<Burst::Deadline> Burst::BlockData::getBestDeadline(const Deadlin
 
 bool Burst::BlockData::forEntries(const std::function<bool(const Poco::JSON::Object&)>& traverseFunction) const
 {
-	Poco::ScopedLock<Poco::Mutex> lock{mutex_};
 	poco_ndc(BlockData::forEntries);
 
 	try
 	{
-		if (entries_ == nullptr)
-			return false;
-
-		auto error = false;
-
-		for (auto iter = entries_->begin(); iter != entries_->end() && !error; ++iter)
-			error = !traverseFunction(*iter);
-
-		// send the overall progress, if any
-		if (!error && !jsonProgress_.isNull())
-			error = !traverseFunction(*jsonProgress_);
-
-		// send the dir progress
-		if (!error)
-			for (auto iter = jsonDirProgress_.begin(); !error && iter != jsonDirProgress_.end(); ++iter)
-				error = !traverseFunction(*iter->second);
-
-		return error;
+		return entries_.forEach(traverseFunction);
 	}
 	catch (const Poco::Exception& e)
 	{
@@ -456,28 +469,41 @@ bool Burst::BlockData::forEntries(const std::function<bool(const Poco::JSON::Obj
 //	return deadlines_;
 //}
 
-std::shared_ptr<Burst::Deadline> Burst::BlockData::getBestDeadlineUnlocked(const Poco::UInt64 accountId, const DeadlineSearchType searchType) const
+std::shared_ptr<Burst::Deadline> Burst::BlockData::getBestOf(const Deadlines& deadlines, const DeadlineSearchType searchType)
 {
-	poco_ndc(BlockData::getBestDeadlineUnlocked);
+	switch (searchType)
+	{
+	case DeadlineSearchType::Found:
+		return deadlines.getBestFound();
+	case DeadlineSearchType::Sent:
+		return deadlines.getBestSent();
+	case DeadlineSearchType::Confirmed:
+		return deadlines.getBestConfirmed();
+	default:
+		return nullptr;
+	}
+}
+
+std::shared_ptr<Burst::Deadline> Burst::BlockData::getBestDeadline(const Poco::UInt64 accountId, const DeadlineSearchType searchType) const
+{
+	poco_ndc(BlockData::getBestDeadline);
 
 	try
 	{
-		const auto iter = deadlines_.find(accountId);
-
-		if (iter == deadlines_.end())
-			return nullptr;
+		std::shared_ptr<Deadlines> accountDeadlines;
 
-		switch (searchType)
 		{
-		case DeadlineSearchType::Found:
-			return iter->second->getBestFound();
-		case DeadlineSearchType::Sent:
-			return iter->second->getBestSent();
-		case DeadlineSearchType::Confirmed:
-			return iter->second->getBestConfirmed();
-		default:
-			return nullptr;
+			const auto& shard = getShard(accountId);
+			Poco::ScopedLock<Poco::FastMutex> lock{shard.mutex};
+			const auto iter = shard.deadlines.find(accountId);
+
+			if (iter == shard.deadlines.end() || iter->second == nullptr)
+				return nullptr;
+
+			accountDeadlines = iter->second;
 		}
+
+		return getBestOf(*accountDeadlines, searchType);
 	}
 	catch (const Poco::Exception& e)
 	{
@@ -487,35 +513,33 @@ std::shared_ptr<Burst::Deadline> Burst::BlockData::getBestDeadlineUnlocked(const
 	}
 }
 
-std::shared_ptr<Burst::Deadline> Burst::BlockData::getBestDeadline(const Poco::UInt64 accountId, const DeadlineSearchType searchType) const
-{
-	Poco::ScopedLock<Poco::Mutex> lock{mutex_};
-	return getBestDeadlineUnlocked(accountId, searchType);
-}
-
-Poco::ActiveResult<std::shared_ptr<Burst::Account>> Burst::BlockData::getLastWinnerAsync(const Wallet& wallet, Accounts& accounts)
+Poco::ActiveResult<std::shared_ptr<Burst::Account>> Burst::BlockData::getLastWinnerAsync(std::shared_ptr<const Wallet> wallet, Accounts& accounts)
 {
-	return DataLoader::getInstance().getLastWinner(make_tuple(std::cref(wallet), std::ref(accounts), std::ref(*this)));
+	return DataLoader::getInstance().getLastWinner(make_tuple(std::move(wallet), std::ref(accounts), std::ref(*this)));
 }
 
 std::shared_ptr<Burst::Deadline> Burst::BlockData::addDeadlineIfBest(Deadline deadline)
 {
-	Poco::ScopedLock<Poco::Mutex> lock{mutex_};
-
 	poco_ndc(BlockData::addDeadlineIfBest);
 
 	try
 	{
-		const auto bestDeadline = getBestDeadlineUnlocked(deadline.getAccountId(), DeadlineSearchType::Found);
+		// only the shard of the account is locked, so submissions for other accounts are not blocked
+		auto& shard = getShard(deadline.getAccountId());
+		Poco::ScopedLock<Poco::FastMutex> lock{shard.mutex};
+
+		auto& accountDeadlines = shard.deadlines[deadline.getAccountId()];
+
+		if (accountDeadlines == nullptr)
+			accountDeadlines = std::make_shared<Deadlines>(this);
+
+		const auto bestDeadline = accountDeadlines->getBestFound();
 
 		if (bestDeadline == nullptr || bestDeadline->getDeadline() > deadline.getDeadline())
 		{
 			auto deadlinePtr = std::make_shared<Deadline>(std::move(deadline));
-			
-			if (addDeadlineUnlocked(deadlinePtr))
-				return deadlinePtr;
-
-			return nullptr;
+			accountDeadlines->add(deadlinePtr);
+			return deadlinePtr;
 		}
 
 		return nullptr;
@@ -535,21 +559,14 @@ void Burst::BlockData::addMessage(const Poco::Message& message) const
 
 	try
 	{
-		{
-			Poco::ScopedLock<Poco::Mutex> lock{mutex_};
+		json.set("type", std::to_string(static_cast<int>(message.getPriority())));
+		json.set("text", message.getText());
+		json.set("source", message.getSource());
+		json.set("line", message.getSourceLine());
+		json.set("file", message.getSourceFile());
+		json.set("time", Poco::DateTimeFormatter::format(Poco::LocalDateTime(message.getTime()), "%H:%M:%S"));
 
-			if (entries_ == nullptr)
-				return;
-			
-			json.set("type", std::to_string(static_cast<int>(message.getPriority())));
-			json.set("text", message.getText());
-			json.set("source", message.getSource());
-			json.set("line", message.getSourceLine());
-			json.set("file", message.getSourceFile());
-			json.set("time", Poco::DateTimeFormatter::format(Poco::LocalDateTime(message.getTime()), "%H:%M:%S"));
-
-			entries_->emplace_back(json);
-		}
+		entries_.add(json);
 
 		if (parent_ != nullptr)
 			parent_->blockDataChangedEvent.notify(this, json);	
@@ -563,29 +580,25 @@ void Burst::BlockData::addMessage(const Poco::Message& message) const
 
 void Burst::BlockData::clearEntries() const
 {
-	Poco::ScopedLock<Poco::Mutex> lock{mutex_};
-	entries_->clear();
+	entries_.clear();
 }
 
 bool Burst::BlockData::forDeadlines(const std::function<bool(const Deadline&)>& traverseFunction) const
 {
-	Poco::ScopedLock<Poco::Mutex> lock{mutex_};
-
 	poco_ndc(BlockData::forDeadlines);
 
 	try
 	{
-		if (deadlines_.empty())
+		const auto allDeadlines = getAllDeadlines();
+
+		if (allDeadlines.empty())
 			return false;
 
 		auto error = false;
 
-		for (auto iterAccounts = deadlines_.begin(); iterAccounts != deadlines_.end() && !error; ++iterAccounts)
+		for (auto iterAccounts = allDeadlines.begin(); iterAccounts != allDeadlines.end() && !error; ++iterAccounts)
 		{
-			if (iterAccounts->second == nullptr)
-				continue;
-
-			const auto deadlines = iterAccounts->second->getDeadlines();
+			const auto deadlines = (*iterAccounts)->getDeadlines();
 
 			for (auto iter = deadlines.begin(); iter != deadlines.end() && !error; ++iter)
 				error = traverseFunction(**iter);
@@ -601,9 +614,94 @@ bool Burst::BlockData::forDeadlines(const std::function<bool(const Deadline&)>&
 	}
 }
 
+void Burst::BlockData::addReadThroughput(ReadThroughput throughput)
+{
+	poco_ndc(BlockData::addReadThroughput);
+
+	try
+	{
+		// only the device totals are compared with the baseline
+		if (throughput.file.empty() && parent_ != nullptr &&
+			parent_->diskHealth_.update(throughput.device, throughput.getBytesPerSecond(), getBlockheight()))
+		{
+			DiskHealth::Device device;
+			parent_->diskHealth_.get(throughput.device, device);
+
+			log_warning(MinerLogger::plotReader, "Dir %s reads slower than usual: %s/s (baseline %s/s)",
+				throughput.device,
+				memToString(static_cast<Poco::UInt64>(device.last), 2),
+				memToString(static_cast<Poco::UInt64>(device.baseline), 2));
+
+			Poco::JSON::Object json;
+			json.set("type", "slow disk");
+			json.set("device", throughput.device);
+			json.set("last", static_cast<Poco::UInt64>(device.last));
+			json.set("baseline", static_cast<Poco::UInt64>(device.baseline));
+			addBlockEntry(json);
+		}
+
+		Poco::ScopedLock<Poco::FastMutex> lock{readThroughputMutex_};
+		readThroughputs_.emplace_back(std::move(throughput));
+	}
+	catch (const Poco::Exception& e)
+	{
+		log_error(MinerLogger::miner, "Could not add the read throughput: %s", e.displayText());
+		log_current_stackframe(MinerLogger::miner);
+	}
+}
+
+std::vector<Burst::ReadThroughput> Burst::BlockData::getReadThroughputs() const
+{
+	Poco::ScopedLock<Poco::FastMutex> lock{readThroughputMutex_};
+	return readThroughputs_;
+}
+
+void Burst::BlockData::Entries::add(const Poco::JSON::Object& entry)
+{
+	Poco::ScopedLock<Poco::FastMutex> lock{mutex_};
+	entries_.emplace_back(entry);
+}
+
+void Burst::BlockData::Entries::clear()
+{
+	Poco::ScopedLock<Poco::FastMutex> lock{mutex_};
+	entries_.clear();
+}
+
+void Burst::BlockData::Entries::setProgress(Poco::JSON::Object::Ptr progress)
+{
+	Poco::ScopedLock<Poco::FastMutex> lock{mutex_};
+	progress_ = std::move(progress);
+}
+
+void Burst::BlockData::Entries::setDirProgress(const std::string& plotDir, Poco::JSON::Object::Ptr progress)
+{
+	Poco::ScopedLock<Poco::FastMutex> lock{mutex_};
+	dirProgress_[plotDir] = std::move(progress);
+}
+
+bool Burst::BlockData::Entries::forEach(const std::function<bool(const Poco::JSON::Object&)>& traverseFunction) const
+{
+	Poco::ScopedLock<Poco::FastMutex> lock{mutex_};
+	auto error = false;
+
+	for (auto iter = entries_.begin(); iter != entries_.end() && !error; ++iter)
+		error = !traverseFunction(*iter);
+
+	// send the overall progress, if any
+	if (!error && !progress_.isNull())
+		error = !traverseFunction(*progress_);
+
+	// send the dir progress
+	if (!error)
+		for (auto iter = dirProgress_.begin(); !error && iter != dirProgress_.end(); ++iter)
+			error = !traverseFunction(*iter->second);
+
+	return error;
+}
+
 Burst::MinerData::MinerData()
-	: blocksWon_(0),
-	  activityWonBlocks_{this, &MinerData::runGetWonBlocks}
+	: blocksWon_(0)
 {
 	poco_ndc(MinerData::MinerData);
 
@@ -640,11 +738,61 @@ Burst::MinerData::MinerData()
 			"	blockTime		REAL NOT NULL," <<
 			"	PRIMARY KEY (id)" <<
 			")", now;
+
+		*dbSession_ <<
+			"CREATE TABLE IF NOT EXISTS read_throughput (" <<
+			"	id				INTEGER NOT NULL," <<
+			"	height			INTEGER NOT NULL," <<
+			"	device			TEXT NOT NULL," <<
+			"	file			TEXT NOT NULL," <<
+			"	bytes			INTEGER NOT NULL," <<
+			"	duration		INTEGER NOT NULL," <<
+			"	PRIMARY KEY (id)" <<
+			")", now;
+
+		*dbSession_ <<
+			"CREATE TABLE IF NOT EXISTS timeline (" <<
+			"	id				INTEGER NOT NULL," <<
+			"	height			INTEGER NOT NULL," <<
+			"	data			TEXT NOT NULL," <<
+			"	PRIMARY KEY (id)" <<
+			")", now;
 	}
 	catch (Poco::Exception& e)
 	{
 		throw Poco::Exception{Poco::format("Could not load/create the database '%s'\n\tReason: %s", databasePath, e.displayText())};
 	}
+
+	migrateDatabase();
+	loadStatistics();
+
+	try
+	{
+		dbWriter_ = std::make_unique<DatabaseWriter>(databasePath);
+	}
+	catch (Poco::Exception& e)
+	{
+		throw Poco::Exception{Poco::format("Could not open the database '%s' for writing\n\tReason: %s", databasePath, e.displayText())};
+	}
+
+	// rebuild the baselines of the devices from the last rounds
+	try
+	{
+		std::vector<std::string> devices;
+		std::vector<Poco::UInt64> heights, bytes, durations;
+
+		*dbSession_ << "SELECT device, height, bytes, duration FROM " <<
+			"(SELECT id, device, height, bytes, duration FROM read_throughput WHERE file = '' ORDER BY id DESC LIMIT 5000) " <<
+			"ORDER BY id ASC",
+			into(devices), into(heights), into(bytes), into(durations), now;
+
+		for (size_t i = 0; i < devices.size(); ++i)
+			diskHealth_.update(devices[i], ReadThroughput{devices[i], "", bytes[i], durations[i]}.getBytesPerSecond(), heights[i]);
+	}
+	catch (Poco::Exception& e)
+	{
+		log_error(MinerLogger::miner, "Could not load the read throughput history: %s", e.displayText());
+	}
 }
 
 Burst::MinerData::~MinerData() = default;
@@ -656,56 +804,12 @@ std::shared_ptr<Burst::BlockData> Burst::MinerData::startNewBlock(Poco::UInt64 b
 	poco_ndc(MinerData::startNewBlock);
 	Poco::ScopedLock<Poco::Mutex> lock{mutex_};
 
-	// save the old data in the historical container
 	if (blockData_ != nullptr)
-	{
-		// add the block to the database
-		try
-		{
-			*dbSession_ <<
-				"INSERT INTO block VALUES (NULL, :height, :scoop, :btarget, :gensig, :diff, :targdl, :roundt, :blockt)",
-				bind(blockData_->getBlockheight()), bind(blockData_->getScoop()), bind(blockData_->getBasetarget()),
-				useRef(blockData_->getGensigStr()), bind(blockData_->getDifficulty()), bind(blockData_->getBlockTargetDeadline()),
-				bind(blockData_->getRoundTime()), bind(blockData_->getBlockTime()), now;
-
-			blockData_->forDeadlines([this](const Deadline& deadline)
-			{
-				try
-				{
-					const auto status = [&]()
-					{
-						if (deadline.isConfirmed())
-							return 3;
+		addToStatistics(*blockData_);
 
-						if (deadline.isSent())
-							return 2;
-
-						if (deadline.isOnTheWay())
-							return 1;
-
-						return 0;
-					}();
-
-					*dbSession_ <<
-						"INSERT INTO deadline VALUES (NULL, :height, :account, :nonce, :value, :file, :miner, :totalplotsize, :status)",
-						bind(deadline.getBlock()), bind(deadline.getAccountId()), bind(deadline.getNonce()), bind(deadline.getDeadline()),
-						bind(deadline.getPlotFile()), bind(deadline.getMiner()), bind(deadline.getTotalPlotsize()), bind(status), now;
-				}
-				catch (Poco::Exception& e)
-				{
-					log_error(MinerLogger::general, "Could not insert deadline %s for block %Lu\n\tReason: %s",
-						deadline.deadlineToReadableString(), deadline.getBlock(), e.displayText());
-				}
-
-				return false;
-			});
-		}
-		catch (Poco::Exception& e)
-		{
-			log_error(MinerLogger::general, "Could not insert block %Lu\n\tReason: %s",
-				blockData_->getBlockheight(), e.displayText());
-		}
-	}
+	// the old data is written into the database in the background
+	if (blockData_ != nullptr && dbWriter_ != nullptr)
+		dbWriter_->write(blockData_);
 
 	try
 	{
@@ -824,45 +928,21 @@ void Burst::MinerData::forAllBlocks(const Poco::UInt64 from, const Poco::UInt64
 	}
 }
 
-Poco::UInt64 Burst::MinerData::runGetWonBlocks(const std::pair<const Wallet*, const Accounts*>& args)
+void Burst::MinerData::setBlocksWon(const Poco::UInt64 blocksWon)
 {
-	poco_ndc(BlockData::runGetWonBlocks);
+	std::shared_ptr<BlockData> blockData;
 
-	try
 	{
-		auto& wallet = *args.first;
-		auto& accounts = *args.second;
-		size_t wonBlocks = 0;
-
-		if (!wallet.isActive())
-			return 0;
-
-		std::vector<Block> blocks;
-
-		for (auto& account : accounts.getAccounts())
-			if (wallet.getAccountBlocks(account->getId(), blocks))
-				wonBlocks += blocks.size();
-
-		bool refresh;
-
-		{
-			Poco::ScopedLock<Poco::Mutex> lock{mutex_};
-			const auto before = blocksWon_.load();
-			blocksWon_.store(wonBlocks);
-			refresh = before != wonBlocks;
-		}
+		Poco::ScopedLock<Poco::Mutex> lock{mutex_};
 
-		if (blockData_ != nullptr && refresh)
-			blockData_->refreshBlockEntry();
+		if (blocksWon_.exchange(blocksWon) == blocksWon)
+			return;
 
-		return wonBlocks;
-	}
-	catch (const Poco::Exception& e)
-	{
-		log_error(MinerLogger::miner, "Could not get the number of won block: %s", e.displayText());
-		log_current_stackframe(MinerLogger::miner);
-		return 0;
+		blockData = blockData_;
 	}
+
+	if (blockData != nullptr)
+		blockData->refreshBlockEntry();
 }
 
 void Burst::MinerData::addMessage(const Poco::Message& message)
@@ -875,59 +955,33 @@ void Burst::MinerData::addMessage(const Poco::Message& message)
 
 std::shared_ptr<Burst::Deadline> Burst::MinerData::getBestDeadlineOverall(bool onlyHistorical) const
 {
-	Poco::ScopedLock<Poco::Mutex> lock{mutex_};
+	Poco::UInt64 to;
 
-	try
 	{
-		Poco::UInt64 from = 0, to = 0;
-
-		if (onlyHistorical)
-		{
-			if (blockData_ == nullptr)
-				*dbSession_ << "SELECT MAX(height) FROM block", into(to), now;
-			else
-				to = blockData_->getBlockheight();
-
-			if (to == 0)
-				return nullptr;
-
-			const auto maxHistoricalBlocks = MinerConfig::getConfig().getMaxHistoricalBlocks();
-
-			if (maxHistoricalBlocks > to)
-				from = 0;
-			else
-				from = to - MinerConfig::getConfig().getMaxHistoricalBlocks();
-		}
+		Poco::ScopedLock<Poco::Mutex> lock{mutex_};
+		to = blockData_ == nullptr ? 0 : blockData_->getBlockheight();
+	}
 
-		std::string query = "SELECT nonce, value, account, height, file, MIN(value) FROM deadline WHERE status = 3 ";
-		
-		if (onlyHistorical)
-			query += " AND height >= :from AND height < :to";
+	Poco::ScopedLock<Poco::FastMutex> lock{statisticsMutex_};
 
-		Poco::UInt64 nonce, value, account, height, minValue;
-		std::string file;
+	if (!onlyHistorical)
+		return statistics_.bestDeadline;
 
-		auto stmt = (*dbSession_ << query, into(nonce), into(value), into(account), into(height), into(file), into(minValue));
+	if (to == 0)
+		to = statistics_.lastHeight;
 
-		if (onlyHistorical)
-		{
-			stmt.bind(from);
-			stmt.bind(to);
-		}
+	if (to == 0)
+		return nullptr;
 
-		stmt.execute();
+	const auto maxHistoricalBlocks = MinerConfig::getConfig().getMaxHistoricalBlocks();
+	const Poco::UInt64 from = maxHistoricalBlocks > to ? 0 : to - maxHistoricalBlocks;
+	std::shared_ptr<Deadline> best;
 
-		if (file.empty())
-			return nullptr;
+	for (auto iter = statistics_.bestDeadlines.lower_bound(from); iter != statistics_.bestDeadlines.end() && iter->first < to; ++iter)
+		if (best == nullptr || iter->second->getDeadline() < best->getDeadline())
+			best = iter->second;
 
-		return std::make_shared<Deadline>(nonce, value, std::make_shared<Account>(account), height, file);
-	}
-	catch (const Poco::Exception& e)
-	{
-		log_error(MinerLogger::miner, "Could not get best overall deadline: %s", e.displayText());
-		log_current_stackframe(MinerLogger::miner);
-		return nullptr;
-	}
+	return best;
 }
 
 const Poco::Timestamp& Burst::MinerData::getStartTime() const
@@ -950,22 +1004,20 @@ Poco::UInt64 Burst::BlockData::getBlockTime() const
 	return blockTime_;
 }
 
-Poco::UInt64 Burst::MinerData::getBlocksMined() const
+Burst::RoundTimeline& Burst::BlockData::getTimeline()
 {
-	poco_ndc(MinerData::getBlocksMined);
+	return timeline_;
+}
 
-	try
-	{
-		Poco::UInt64 blocksMined;
-		*dbSession_ << "SELECT COUNT(*) FROM block", into(blocksMined), now;
-		return blocksMined;
-	}
-	catch (const Poco::Exception& e)
-	{
-		log_error(MinerLogger::miner, "Could not get mined blocks: %s", e.displayText());
-		log_current_stackframe(MinerLogger::miner);
-		return 0;
-	}
+const Burst::RoundTimeline& Burst::BlockData::getTimeline() const
+{
+	return timeline_;
+}
+
+Poco::UInt64 Burst::MinerData::getBlocksMined() const
+{
+	Poco::ScopedLock<Poco::FastMutex> lock{statisticsMutex_};
+	return statistics_.blocksMined;
 }
 
 Poco::UInt64 Burst::MinerData::getBlocksWon() const
@@ -1038,58 +1090,156 @@ std::shared_ptr<const Burst::BlockData> Burst::MinerData::getHistoricalBlockData
 //	return blockData->getLastWinner();
 //}
 
-std::vector<std::shared_ptr<Burst::BlockData>> Burst::MinerData::getAllHistoricalBlockData() const
+std::vector<Burst::HistoryEntry> Burst::MinerData::getHistory(Poco::UInt64 before, Poco::UInt64 limit) const
 {
-	poco_ndc(MinerData::getAllHistoricalBlockData);
+	poco_ndc(MinerData::getHistory);
 
 	try
 	{
-		const auto from = getCurrentBlockheight() - MinerConfig::getConfig().getMaxHistoricalBlocks();
-		const auto to = getCurrentBlockheight();
-		return getHistoricalBlocks(from, to);
+		// the pending blocks are taken before the query, a block committed in between is then found twice,
+		// but never missed
+		const auto pending = dbWriter_ != nullptr ? dbWriter_->getPending() : std::vector<std::shared_ptr<const BlockData>>{};
+
+		std::vector<Poco::UInt64> heights, baseTargets, difficulties, blockTimes, confirmed, best;
+		std::vector<double> roundTimes;
+
+		// the deadlines are aggregated per block with the (height, status) index
+		*dbSession_ << "SELECT height, baseTarget, difficulty, roundTime, blockTime, " <<
+			"(SELECT COUNT(*) FROM deadline WHERE deadline.height = block.height AND status = 3), " <<
+			"(SELECT IFNULL(MIN(value), 0) FROM deadline WHERE deadline.height = block.height AND status = 3) " <<
+			"FROM block WHERE height < :before ORDER BY height DESC LIMIT :limit",
+			into(heights), into(baseTargets), into(difficulties), into(roundTimes), into(blockTimes),
+			into(confirmed), into(best), use(before), use(limit), now;
+
+		std::vector<HistoryEntry> history;
+		history.reserve(heights.size());
+
+		for (size_t i = 0; i < heights.size(); ++i)
+		{
+			HistoryEntry entry;
+			entry.height = heights[i];
+			entry.baseTarget = baseTargets[i];
+			entry.difficulty = difficulties[i];
+			entry.roundTime = roundTimes[i];
+			entry.blockTime = blockTimes[i];
+			entry.confirmedDeadlines = confirmed[i];
+			entry.bestDeadline = best[i];
+			history.emplace_back(entry);
+		}
+
+		for (const auto& block : pending)
+		{
+			const auto height = block->getBlockheight();
+
+			if (height >= before || std::any_of(history.begin(), history.end(),
+				[height](const HistoryEntry& entry) { return entry.height == height; }))
+				continue;
+
+			HistoryEntry entry;
+			entry.height = height;
+			entry.baseTarget = block->getBasetarget();
+			entry.difficulty = block->getDifficulty();
+			entry.roundTime = block->getRoundTime();
+			entry.blockTime = block->getBlockTime();
+
+			block->forDeadlines([&entry](const Deadline& deadline)
+			{
+				if (deadline.isConfirmed())
+				{
+					if (entry.confirmedDeadlines == 0 || deadline.getDeadline() < entry.bestDeadline)
+						entry.bestDeadline = deadline.getDeadline();
+
+					++entry.confirmedDeadlines;
+				}
+
+				return false;
+			});
+
+			history.emplace_back(entry);
+		}
+
+		if (!pending.empty())
+		{
+			std::sort(history.begin(), history.end(), [](const HistoryEntry& lhs, const HistoryEntry& rhs)
+			{
+				return lhs.height > rhs.height;
+			});
+
+			if (history.size() > limit)
+				history.resize(static_cast<size_t>(limit));
+		}
+
+		return history;
 	}
 	catch (const Poco::Exception& e)
 	{
-		log_error(MinerLogger::miner, "Could not get all historical block data: %s", e.displayText());
+		log_error(MinerLogger::miner, "Could not get the history: %s", e.displayText());
 		log_current_stackframe(MinerLogger::miner);
 		return {};
 	}
 }
 
-Poco::UInt64 Burst::MinerData::getConfirmedDeadlines() const
+std::vector<Burst::HistorySummary> Burst::MinerData::getDailySummaries(Poco::UInt64 before, Poco::UInt64 limit) const
 {
-	poco_ndc(MinerData::getConfirmedDeadlines);
+	poco_ndc(MinerData::getDailySummaries);
 
 	try
 	{
-		Poco::UInt64 deadlinesConfirmed;
-		*dbSession_ << "SELECT COUNT(*) FROM deadline WHERE status = 3", into(deadlinesConfirmed), now;
-		return deadlinesConfirmed;
+		std::vector<Poco::UInt64> days, fromHeights, toHeights, blocks, minDifficulties, maxDifficulties,
+			confirmed, deadlineSums, best;
+		std::vector<double> roundTimeSums, blockTimeSums;
+
+		*dbSession_ << "SELECT day, fromHeight, toHeight, blocks, minDifficulty, maxDifficulty, roundTimeSum, " <<
+			"blockTimeSum, confirmedDeadlines, deadlineSum, IFNULL(bestDeadline, 0) " <<
+			"FROM daily_summary WHERE day < :before ORDER BY day DESC LIMIT :limit",
+			into(days), into(fromHeights), into(toHeights), into(blocks), into(minDifficulties), into(maxDifficulties),
+			into(roundTimeSums), into(blockTimeSums), into(confirmed), into(deadlineSums), into(best),
+			use(before), use(limit), now;
+
+		std::vector<HistorySummary> summaries;
+		summaries.reserve(days.size());
+
+		for (size_t i = 0; i < days.size(); ++i)
+		{
+			HistorySummary summary;
+			summary.day = days[i];
+			summary.fromHeight = fromHeights[i];
+			summary.toHeight = toHeights[i];
+			summary.blocks = blocks[i];
+			summary.minDifficulty = minDifficulties[i];
+			summary.maxDifficulty = maxDifficulties[i];
+			summary.roundTimeSum = roundTimeSums[i];
+			summary.blockTimeSum = blockTimeSums[i];
+			summary.confirmedDeadlines = confirmed[i];
+			summary.deadlineSum = deadlineSums[i];
+			summary.bestDeadline = best[i];
+			summaries.emplace_back(summary);
+		}
+
+		return summaries;
 	}
 	catch (const Poco::Exception& e)
 	{
-		log_error(MinerLogger::miner, "Could not get confirmed deadlines: %s", e.displayText());
+		log_error(MinerLogger::miner, "Could not get the daily summaries: %s", e.displayText());
 		log_current_stackframe(MinerLogger::miner);
-		return 0;
+		return {};
 	}
 }
 
+Poco::UInt64 Burst::MinerData::getConfirmedDeadlines() const
+{
+	Poco::ScopedLock<Poco::FastMutex> lock{statisticsMutex_};
+	return statistics_.confirmedDeadlines;
+}
+
 Poco::UInt64 Burst::MinerData::getAverageDeadline() const
 {
-	poco_ndc(MinerData::getAverageDeadline);
+	Poco::ScopedLock<Poco::FastMutex> lock{statisticsMutex_};
 
-	try
-	{
-		Poco::UInt64 avg = 0;
-		*dbSession_ << "SELECT AVG(value) FROM deadline WHERE status = 3", into(avg), now;
-		return avg;
-	}
-	catch (const Poco::Exception& e)
-	{
-		log_error(MinerLogger::miner, "Could not get average deadline: %s", e.displayText());
-		log_current_stackframe(MinerLogger::miner);
+	if (statistics_.confirmedDeadlines == 0)
 		return 0;
-	}
+
+	return statistics_.confirmedDeadlineSum / statistics_.confirmedDeadlines;
 }
 
 Poco::Int64 Burst::MinerData::getDifficultyDifference() const
@@ -1118,40 +1268,249 @@ Poco::Int64 Burst::MinerData::getDifficultyDifference() const
 
 Burst::HighscoreValue<Poco::UInt64> Burst::MinerData::getLowestDifficulty() const
 {
-	poco_ndc(MinerData::getLowestDifficulty);
+	Poco::ScopedLock<Poco::FastMutex> lock{statisticsMutex_};
+	return statistics_.lowestDifficulty;
+}
+
+Burst::HighscoreValue<Poco::UInt64> Burst::MinerData::getHighestDifficulty() const
+{
+	Poco::ScopedLock<Poco::FastMutex> lock{statisticsMutex_};
+	return statistics_.highestDifficulty;
+}
+
+void Burst::MinerData::migrateDatabase()
+{
+	poco_ndc(MinerData::migrateDatabase);
+
+	// every entry migrates the schema to the next version (index + 1)
+	static const std::vector<std::vector<std::string>> migrations = {
+		{
+			"CREATE INDEX IF NOT EXISTS deadline_height_status ON deadline (height, status)",
+			"CREATE INDEX IF NOT EXISTS block_height ON block (height)"
+		},
+		{
+			"CREATE TABLE IF NOT EXISTS daily_summary ("
+			"	day					INTEGER NOT NULL,"
+			"	fromHeight			INTEGER NOT NULL,"
+			"	toHeight			INTEGER NOT NULL,"
+			"	blocks				INTEGER NOT NULL,"
+			"	minDifficulty		INTEGER NOT NULL,"
+			"	minDifficultyHeight	INTEGER NOT NULL,"
+			"	maxDifficulty		INTEGER NOT NULL,"
+			"	maxDifficultyHeight	INTEGER NOT NULL,"
+			"	roundTimeSum		REAL NOT NULL,"
+			"	blockTimeSum		REAL NOT NULL,"
+			"	confirmedDeadlines	INTEGER NOT NULL,"
+			"	deadlineSum			INTEGER NOT NULL,"
+			"	bestNonce			INTEGER,"
+			"	bestDeadline		INTEGER,"
+			"	bestAccount			INTEGER,"
+			"	bestHeight			INTEGER,"
+			"	bestFile			TEXT,"
+			"	PRIMARY KEY (day)"
+			")",
+			"CREATE INDEX IF NOT EXISTS timeline_height ON timeline (height)",
+			"CREATE INDEX IF NOT EXISTS read_throughput_height ON read_throughput (height)"
+		},
+		{
+			"CREATE TABLE IF NOT EXISTS account ("
+			"	id				INTEGER NOT NULL,"
+			"	name			TEXT NOT NULL,"
+			"	rewardRecipient	INTEGER NOT NULL,"
+			"	blocks			TEXT NOT NULL,"
+			"	updated			INTEGER NOT NULL,"
+			"	PRIMARY KEY (id)"
+			")"
+		},
+		{
+			// the height of the newest won block, the account blocks are only fetched above it
+			"ALTER TABLE account ADD COLUMN height INTEGER NOT NULL DEFAULT 0"
+		},
+		{
+			// the read throughput of the devices on the compacted days, the rows per plot file are kept raw until then
+			"CREATE TABLE IF NOT EXISTS daily_read_throughput ("
+			"	day			INTEGER NOT NULL,"
+			"	device		TEXT NOT NULL,"
+			"	rounds		INTEGER NOT NULL,"
+			"	bytes		INTEGER NOT NULL,"
+			"	duration	INTEGER NOT NULL,"
+			"	PRIMARY KEY (day, device)"
+			")"
+		}
+	};
 
 	try
 	{
-		Poco::UInt64 height, difficulty;
-		*dbSession_ << "SELECT height, MIN(difficulty) FROM block", into(height), into(difficulty), now;
-		return {height, difficulty};
+		Poco::UInt64 version = 0;
+		*dbSession_ << "PRAGMA user_version", into(version), now;
+
+		for (; version < migrations.size(); ++version)
+		{
+			log_system(MinerLogger::general, "Migrating the database to version %Lu", version + 1);
+
+			dbSession_->begin();
+
+			for (const auto& statement : migrations[version])
+				*dbSession_ << statement, now;
+
+			*dbSession_ << "PRAGMA user_version = " << version + 1, now;
+			dbSession_->commit();
+		}
 	}
-	catch (const Poco::Exception& e)
+	catch (Poco::Exception& e)
 	{
-		log_error(MinerLogger::miner, "Could not get lowest difficulty: %s", e.displayText());
-		log_current_stackframe(MinerLogger::miner);
-		return {};
+		if (dbSession_->isTransaction())
+			dbSession_->rollback();
+
+		throw Poco::Exception{Poco::format("Could not migrate the database\n\tReason: %s", e.displayText())};
 	}
 }
 
-Burst::HighscoreValue<Poco::UInt64> Burst::MinerData::getHighestDifficulty() const
+void Burst::MinerData::loadStatistics()
 {
-	poco_ndc(MinerData::getHighestDifficulty);
+	poco_ndc(MinerData::loadStatistics);
 
 	try
 	{
-		Poco::UInt64 height, difficulty;
-		*dbSession_ << "SELECT height, MAX(difficulty) FROM block", into(height), into(difficulty), now;
-		return {height, difficulty};
+		MiningStatistics statistics;
+
+		*dbSession_ << "SELECT COUNT(*), IFNULL(MAX(height), 0) FROM block",
+			into(statistics.blocksMined), into(statistics.lastHeight), now;
+		*dbSession_ << "SELECT COUNT(*), IFNULL(SUM(value), 0) FROM deadline WHERE status = 3",
+			into(statistics.confirmedDeadlines), into(statistics.confirmedDeadlineSum), now;
+
+		if (statistics.blocksMined > 0)
+		{
+			*dbSession_ << "SELECT height, MIN(difficulty) FROM block",
+				into(statistics.lowestDifficulty.height), into(statistics.lowestDifficulty.value), now;
+			*dbSession_ << "SELECT height, MAX(difficulty) FROM block",
+				into(statistics.highestDifficulty.height), into(statistics.highestDifficulty.value), now;
+		}
+
+		const auto maxHistoricalBlocks = MinerConfig::getConfig().getMaxHistoricalBlocks();
+		Poco::UInt64 from = maxHistoricalBlocks > statistics.lastHeight ? 0 : statistics.lastHeight - maxHistoricalBlocks;
+		std::vector<Poco::UInt64> nonces, values, accounts, heights, minValues;
+		std::vector<std::string> files;
+
+		// the best deadline of every recent block
+		*dbSession_ << "SELECT nonce, value, account, height, file, MIN(value) FROM deadline " <<
+			"WHERE status = 3 AND height >= :from GROUP BY height",
+			into(nonces), into(values), into(accounts), into(heights), into(files), into(minValues), use(from), now;
+
+		for (size_t i = 0; i < nonces.size(); ++i)
+			statistics.bestDeadlines[heights[i]] = std::make_shared<Deadline>(nonces[i], values[i],
+				std::make_shared<Account>(accounts[i]), heights[i], files[i]);
+
+		// the best deadline overall
+		nonces.clear(); values.clear(); accounts.clear(); heights.clear(); files.clear(); minValues.clear();
+
+		*dbSession_ << "SELECT nonce, value, account, height, file, MIN(value) FROM deadline WHERE status = 3",
+			into(nonces), into(values), into(accounts), into(heights), into(files), into(minValues), now;
+
+		if (!files.empty() && !files.front().empty())
+			statistics.bestDeadline = std::make_shared<Deadline>(nonces.front(), values.front(),
+				std::make_shared<Account>(accounts.front()), heights.front(), files.front());
+
+		// the days, that were compacted and have no raw rows anymore
+		Poco::UInt64 days = 0, blocks = 0, lastHeight = 0, confirmed = 0, deadlineSum = 0;
+
+		*dbSession_ << "SELECT COUNT(*), IFNULL(SUM(blocks), 0), IFNULL(MAX(toHeight), 0), " <<
+			"IFNULL(SUM(confirmedDeadlines), 0), IFNULL(SUM(deadlineSum), 0) FROM daily_summary",
+			into(days), into(blocks), into(lastHeight), into(confirmed), into(deadlineSum), now;
+
+		if (days > 0)
+		{
+			HighscoreValue<Poco::UInt64> lowest{0, 0}, highest{0, 0};
+
+			*dbSession_ << "SELECT minDifficultyHeight, MIN(minDifficulty) FROM daily_summary",
+				into(lowest.height), into(lowest.value), now;
+			*dbSession_ << "SELECT maxDifficultyHeight, MAX(maxDifficulty) FROM daily_summary",
+				into(highest.height), into(highest.value), now;
+
+			if (statistics.blocksMined == 0 || lowest.value < statistics.lowestDifficulty.value)
+				statistics.lowestDifficulty = lowest;
+
+			if (statistics.blocksMined == 0 || highest.value > statistics.highestDifficulty.value)
+				statistics.highestDifficulty = highest;
+
+			statistics.blocksMined += blocks;
+			statistics.lastHeight = std::max(statistics.lastHeight, lastHeight);
+			statistics.confirmedDeadlines += confirmed;
+			statistics.confirmedDeadlineSum += deadlineSum;
+
+			nonces.clear(); values.clear(); accounts.clear(); heights.clear(); files.clear(); minValues.clear();
+
+			*dbSession_ << "SELECT bestNonce, bestDeadline, bestAccount, bestHeight, bestFile, MIN(bestDeadline) " <<
+				"FROM daily_summary WHERE bestDeadline IS NOT NULL",
+				into(nonces), into(values), into(accounts), into(heights), into(files), into(minValues), now;
+
+			if (!files.empty() && !files.front().empty() &&
+				(statistics.bestDeadline == nullptr || values.front() < statistics.bestDeadline->getDeadline()))
+				statistics.bestDeadline = std::make_shared<Deadline>(nonces.front(), values.front(),
+					std::make_shared<Account>(accounts.front()), heights.front(), files.front());
+		}
+
+		Poco::ScopedLock<Poco::FastMutex> lock{statisticsMutex_};
+		statistics_ = std::move(statistics);
 	}
 	catch (const Poco::Exception& e)
 	{
-		log_error(MinerLogger::miner, "Could not get highest difficulty: %s", e.displayText());
+		log_error(MinerLogger::miner, "Could not load the statistics: %s", e.displayText());
 		log_current_stackframe(MinerLogger::miner);
-		return {};
 	}
 }
 
+void Burst::MinerData::addToStatistics(const BlockData& block)
+{
+	const auto height = block.getBlockheight();
+	const auto difficulty = block.getDifficulty();
+	Poco::UInt64 confirmed = 0, confirmedSum = 0;
+	std::shared_ptr<Deadline> best;
+
+	block.forDeadlines([&](const Deadline& deadline)
+	{
+		if (deadline.isConfirmed())
+		{
+			++confirmed;
+			confirmedSum += deadline.getDeadline();
+
+			if (best == nullptr || deadline.getDeadline() < best->getDeadline())
+				best = std::make_shared<Deadline>(deadline.getNonce(), deadline.getDeadline(),
+					std::make_shared<Account>(deadline.getAccountId()), height, deadline.getPlotFile());
+		}
+
+		return false;
+	});
+
+	Poco::ScopedLock<Poco::FastMutex> lock{statisticsMutex_};
+
+	if (statistics_.blocksMined == 0 || difficulty < statistics_.lowestDifficulty.value)
+		statistics_.lowestDifficulty = {height, difficulty};
+
+	if (statistics_.blocksMined == 0 || difficulty > statistics_.highestDifficulty.value)
+		statistics_.highestDifficulty = {height, difficulty};
+
+	++statistics_.blocksMined;
+	statistics_.lastHeight = std::max(statistics_.lastHeight, height);
+	statistics_.confirmedDeadlines += confirmed;
+	statistics_.confirmedDeadlineSum += confirmedSum;
+
+	if (best != nullptr)
+	{
+		if (statistics_.bestDeadline == nullptr || best->getDeadline() < statistics_.bestDeadline->getDeadline())
+			statistics_.bestDeadline = best;
+
+		statistics_.bestDeadlines[height] = best;
+	}
+
+	// forget the blocks, that are not historical anymore
+	const auto maxHistoricalBlocks = MinerConfig::getConfig().getMaxHistoricalBlocks();
+
+	if (height > maxHistoricalBlocks)
+		statistics_.bestDeadlines.erase(statistics_.bestDeadlines.begin(),
+			statistics_.bestDeadlines.lower_bound(height - maxHistoricalBlocks));
+}
+
 Poco::UInt64 Burst::MinerData::getCurrentBlockheight() const
 {
 	Poco::ScopedLock<Poco::Mutex> lock{mutex_};
@@ -1170,8 +1529,76 @@ Poco::UInt64 Burst::MinerData::getCurrentScoopNum() const
 	return blockData_ == nullptr ? 0 : blockData_->getScoop();
 }
 
-Poco::ActiveResult<Poco::UInt64> Burst::MinerData::getWonBlocksAsync(const Wallet& wallet, const Accounts& accounts)
+Burst::DiskHealth& Burst::MinerData::getDiskHealth()
 {
-	const auto tuple = std::make_pair(&wallet, &accounts);
-	return activityWonBlocks_(tuple);
+	return diskHealth_;
+}
+
+const Burst::DiskHealth& Burst::MinerData::getDiskHealth() const
+{
+	return diskHealth_;
+}
+
+Poco::JSON::Array Burst::MinerData::getReadThroughputHistory(const Poco::UInt64 rounds) const
+{
+	poco_ndc(MinerData::getReadThroughputHistory);
+
+	Poco::JSON::Array json;
+
+	try
+	{
+		std::vector<std::string> devices, files;
+		std::vector<Poco::UInt64> heights, bytes, durations;
+		const auto currentHeight = getCurrentBlockheight();
+		auto fromHeight = currentHeight > rounds ? currentHeight - rounds : 0;
+
+		*dbSession_ << "SELECT height, device, file, bytes, duration FROM read_throughput WHERE height >= :from ORDER BY id",
+			into(heights), into(devices), into(files), into(bytes), into(durations), use(fromHeight), now;
+
+		for (size_t i = 0; i < heights.size(); ++i)
+		{
+			Poco::JSON::Object entry;
+			entry.set("height", heights[i]);
+			entry.set("device", devices[i]);
+			entry.set("file", files[i]);
+			entry.set("bytes", bytes[i]);
+			entry.set("duration", durations[i]);
+			entry.set("bytesPerSecond", static_cast<Poco::UInt64>(
+				ReadThroughput{devices[i], files[i], bytes[i], durations[i]}.getBytesPerSecond()));
+			json.add(entry);
+		}
+	}
+	catch (const Poco::Exception& e)
+	{
+		log_error(MinerLogger::miner, "Could not load the read throughput history: %s", e.displayText());
+		log_current_stackframe(MinerLogger::miner);
+	}
+
+	return json;
+}
+
+bool Burst::MinerData::getRoundTimeline(const Poco::UInt64 blockheight, std::string& timeline) const
+{
+	poco_ndc(MinerData::getRoundTimeline);
+
+	try
+	{
+		std::vector<std::string> data;
+		auto height = blockheight;
+
+		*dbSession_ << "SELECT data FROM timeline WHERE height = :height ORDER BY id DESC LIMIT 1",
+			into(data), use(height), now;
+
+		if (data.empty())
+			return false;
+
+		timeline = data.front();
+		return true;
+	}
+	catch (const Poco::Exception& e)
+	{
+		log_error(MinerLogger::miner, "Could not load the timeline of block %Lu: %s", blockheight, e.displayText());
+		log_current_stackframe(MinerLogger::miner);
+		return false;
+	}
 }
@@ -29,11 +29,16 @@
 #include <Poco/ActiveDispatcher.h>
 #include <Poco/ActiveMethod.h>
 #include <unordered_map>
+#include <map>
 #include <atomic>
+#include <array>
 #include <functional>
 #include <Poco/BasicEvent.h>
 #include <Poco/Message.h>
 #include <Poco/Data/Session.h>
+#include "RoundTimeline.hpp"
+#include "plots/DiskHealth.hpp"
+#include "DatabaseWriter.hpp"
 
 namespace Burst
 {
@@ -63,6 +68,7 @@ namespace Burst
 		void refreshBlockEntry() const;
 		void refreshConfig() const;
 		void refreshPlotDirs() const;
+		void refreshLastRoundTimeline() const;
 		void setProgress(float progressRead, float progressVerification, Poco::UInt64 blockheight);
 		void setProgress(const std::string& plotDir, float progress, Poco::UInt64 blockheight);
 		void setBlockTime(Poco::UInt64 bTime);
@@ -75,6 +81,8 @@ namespace Burst
 		std::shared_ptr<Account> getLastWinner() const;
 		double getRoundTime() const;
 		Poco::UInt64 getBlockTime() const;
+		RoundTimeline& getTimeline();
+		const RoundTimeline& getTimeline() const;
 		
 		const GensigData& getGensig() const;
 		const std::string& getGensigStr() const;
@@ -84,7 +92,7 @@ namespace Burst
 		bool forEntries(const std::function<bool(const Poco::JSON::Object&)>& traverseFunction) const;
 		//const std::unordered_map<AccountId, Deadlines>& getDeadlines() const;
 		std::shared_ptr<Deadline> getBestDeadline(Poco::UInt64 accountId, DeadlineSearchType searchType) const;
-		Poco::ActiveResult<std::shared_ptr<Account>> getLastWinnerAsync(const Wallet& wallet, Accounts& accounts);
+		Poco::ActiveResult<std::shared_ptr<Account>> getLastWinnerAsync(std::shared_ptr<const Wallet> wallet, Accounts& accounts);
 
 		std::shared_ptr<Deadline> addDeadlineIfBest(Deadline deadline);
 
@@ -93,6 +101,9 @@ namespace Burst
 
 		bool forDeadlines(const std::function<bool(const Deadline&)>& traverseFunction) const;
 
+		void addReadThroughput(ReadThroughput throughput);
+		std::vector<ReadThroughput> getReadThroughputs() const;
+
 	protected:
 		
 		void addBlockEntry(Poco::JSON::Object entry) const;
@@ -107,18 +118,50 @@ namespace Burst
 
 			static DataLoader& getInstance();
 
-			Poco::ActiveMethod<std::shared_ptr<Account>, std::tuple<const Wallet&, Accounts&, BlockData&>, DataLoader,
+			Poco::ActiveMethod<std::shared_ptr<Account>, std::tuple<std::shared_ptr<const Wallet>, Accounts&, BlockData&>, DataLoader,
 			                   Poco::ActiveStarter<ActiveDispatcher>> getLastWinner;
 
 		private:
-			std::shared_ptr<Account> runGetLastWinner(const std::tuple<const Wallet&, Accounts&, BlockData&>& args);
+			std::shared_ptr<Account> runGetLastWinner(const std::tuple<std::shared_ptr<const Wallet>, Accounts&, BlockData&>& args);
+		};
+
+		/**
+		 * \brief All deadlines of the accounts that are mapped to the shard.
+		 * Submissions for different accounts usually lock different shards.
+		 */
+		struct DeadlineShard
+		{
+			std::unordered_map<AccountId, std::shared_ptr<Deadlines>> deadlines;
+			mutable Poco::FastMutex mutex;
+		};
+
+		/**
+		 * \brief The entries and progress states that are shown in the web UI.
+		 * They have their own lock, so the UI does not block the deadline processing.
+		 */
+		class Entries
+		{
+		public:
+			void add(const Poco::JSON::Object& entry);
+			void clear();
+			void setProgress(Poco::JSON::Object::Ptr progress);
+			void setDirProgress(const std::string& plotDir, Poco::JSON::Object::Ptr progress);
+			bool forEach(const std::function<bool(const Poco::JSON::Object&)>& traverseFunction) const;
+
+		private:
+			std::vector<Poco::JSON::Object> entries_;
+			Poco::JSON::Object::Ptr progress_;
+			std::unordered_map<std::string, Poco::JSON::Object::Ptr> dirProgress_;
+			mutable Poco::FastMutex mutex_;
 		};
 
 	private:
-		std::shared_ptr<Deadline> getBestDeadlineUnlocked(Poco::UInt64 accountId,
-			DeadlineSearchType searchType) const;
+		DeadlineShard& getShard(AccountId accountId);
+		const DeadlineShard& getShard(AccountId accountId) const;
+		static std::shared_ptr<Deadline> getBestOf(const Deadlines& deadlines, DeadlineSearchType searchType);
+		std::vector<std::shared_ptr<Deadlines>> getAllDeadlines() const;
 
-		bool addDeadlineUnlocked(std::shared_ptr<Deadline> deadline);
+		static constexpr size_t deadlineShardCount = 16;
 
 		std::atomic<Poco::UInt64> blockHeight_;
 		std::atomic<Poco::UInt64> scoop_{};
@@ -128,13 +171,17 @@ namespace Burst
 		std::string genSigStr_ = "";
 		double roundTime_;
 		Poco::UInt64 blockTime_{};
-		std::shared_ptr<std::vector<Poco::JSON::Object>> entries_;
+		mutable Entries entries_;
 		std::shared_ptr<Account> lastWinner_ = nullptr;
-		std::unordered_map<AccountId, std::shared_ptr<Deadlines>> deadlines_;
+		std::array<DeadlineShard, deadlineShardCount> deadlineShards_;
+		// the value of the best confirmed deadline, only a better value wins the CAS
+		std::atomic<Poco::UInt64> bestDeadlineValue_;
+		// only accessed with std::atomic_load/std::atomic_compare_exchange
 		std::shared_ptr<Deadline> bestDeadline_;
+		RoundTimeline timeline_;
+		std::vector<ReadThroughput> readThroughputs_;
+		mutable Poco::FastMutex readThroughputMutex_;
 		MinerData* parent_;
-		Poco::JSON::Object::Ptr jsonProgress_;
-		std::unordered_map<std::string, Poco::JSON::Object::Ptr> jsonDirProgress_;
 		mutable Poco::Mutex mutex_;
 
 		friend class Deadlines;
@@ -147,6 +194,54 @@ namespace Burst
 		T value;
 	};
 
+	/**
+	 * \brief Running aggregates over all mined blocks.
+	 * They are seeded from the database once and updated with every finished block,
+	 * so the statistics never scan the whole tables.
+	 */
+	struct MiningStatistics
+	{
+		Poco::UInt64 blocksMined = 0;
+		Poco::UInt64 lastHeight = 0;
+		Poco::UInt64 confirmedDeadlines = 0;
+		Poco::UInt64 confirmedDeadlineSum = 0;
+		HighscoreValue<Poco::UInt64> lowestDifficulty{0, 0};
+		HighscoreValue<Poco::UInt64> highestDifficulty{0, 0};
+		std::shared_ptr<Deadline> bestDeadline;
+		// the best confirmed deadline of the last historical blocks
+		std::map<Poco::UInt64, std::shared_ptr<Deadline>> bestDeadlines;
+	};
+
+	/**
+	 * \brief One mined block of the history without its deadlines.
+	 */
+	struct HistoryEntry
+	{
+		Poco::UInt64 height = 0;
+		Poco::UInt64 baseTarget = 0;
+		Poco::UInt64 difficulty = 0;
+		double roundTime = 0;
+		Poco::UInt64 blockTime = 0;
+		Poco::UInt64 confirmedDeadlines = 0;
+		// only valid, if there is at least one confirmed deadline
+		Poco::UInt64 bestDeadline = 0;
+	};
+
+	/**
+	 * \brief The summary of one compacted day of the history.
+	 */
+	struct HistorySummary
+	{
+		Poco::UInt64 day = 0;
+		Poco::UInt64 fromHeight = 0, toHeight = 0;
+		Poco::UInt64 blocks = 0;
+		Poco::UInt64 minDifficulty = 0, maxDifficulty = 0;
+		double roundTimeSum = 0, blockTimeSum = 0;
+		Poco::UInt64 confirmedDeadlines = 0, deadlineSum = 0;
+		// only valid, if there is at least one confirmed deadline
+		Poco::UInt64 bestDeadline = 0;
+	};
+
 	class MinerData : public Poco::ActiveDispatcher
 	{
 	public:
@@ -164,7 +259,6 @@ namespace Burst
 		std::shared_ptr<BlockData> getBlockData();
 		std::shared_ptr<const BlockData> getBlockData() const;
 		std::shared_ptr<const BlockData> getHistoricalBlockData(Poco::UInt32 roundsBefore) const;
-		std::vector<std::shared_ptr<BlockData>> getAllHistoricalBlockData() const;
 		Poco::UInt64 getConfirmedDeadlines() const;
 		Poco::UInt64 getAverageDeadline() const;
 		Poco::Int64 getDifficultyDifference() const;
@@ -174,15 +268,43 @@ namespace Burst
 		Poco::UInt64 getCurrentBlockheight() const;
 		Poco::UInt64 getCurrentBasetarget() const;
 		Poco::UInt64 getCurrentScoopNum() const;
-		Poco::ActiveResult<Poco::UInt64> getWonBlocksAsync(const Wallet& wallet, const Accounts& accounts);
+
+		/**
+		 * \brief Sets the number of blocks, the own accounts have won.
+		 * \param blocksWon The number of won blocks.
+		 */
+		void setBlocksWon(Poco::UInt64 blocksWon);
+
+		bool getRoundTimeline(Poco::UInt64 blockheight, std::string& timeline) const;
+		DiskHealth& getDiskHealth();
+		const DiskHealth& getDiskHealth() const;
+		Poco::JSON::Array getReadThroughputHistory(Poco::UInt64 rounds) const;
+
+		/**
+		 * \brief Returns a page of the raw history, the newest block first.
+		 * \param before Only blocks below this height are returned (the cursor).
+		 * \param limit The maximum number of blocks.
+		 * \return The blocks.
+		 */
+		std::vector<HistoryEntry> getHistory(Poco::UInt64 before, Poco::UInt64 limit) const;
+
+		/**
+		 * \brief Returns a page of the compacted history, the newest day first.
+		 * \param before Only days below this day are returned (the cursor).
+		 * \param limit The maximum number of days.
+		 * \return The days.
+		 */
+		std::vector<HistorySummary> getDailySummaries(Poco::UInt64 before, Poco::UInt64 limit) const;
 
 		Poco::BasicEvent<const Poco::JSON::Object> blockDataChangedEvent;
 		std::vector<std::shared_ptr<BlockData>> getHistoricalBlocks(Poco::UInt64 from, Poco::UInt64 to) const;
 
 		void forAllBlocks(Poco::UInt64 from, Poco::UInt64 to, const std::function<bool(std::shared_ptr<BlockData>&)>& traverseFunction) const;
 
-	protected:
-		Poco::UInt64 runGetWonBlocks(const std::pair<const Wallet*, const Accounts*>& args);
+	private:
+		void migrateDatabase();
+		void loadStatistics();
+		void addToStatistics(const BlockData& block);
 
 	private:
 		Poco::Timestamp startTime_ = {};
@@ -191,9 +313,10 @@ namespace Burst
 		mutable Poco::Mutex mutex_;
 
 		std::unique_ptr<Poco::Data::Session> dbSession_ = nullptr;
-
-		Poco::ActiveMethod<Poco::UInt64, std::pair<const Wallet*, const Accounts*>, MinerData,
-						   Poco::ActiveStarter<MinerData>> activityWonBlocks_;
+		DiskHealth diskHealth_;
+		MiningStatistics statistics_;
+		mutable Poco::FastMutex statisticsMutex_;
+		std::unique_ptr<DatabaseWriter> dbWriter_ = nullptr;
 
 		friend class BlockData;
 	};
@@ -0,0 +1,219 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "Numa.hpp"
+#include <Poco/Mutex.h>
+#include <Poco/NumberParser.h>
+#include <Poco/StringTokenizer.h>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+#ifdef __linux__
+  #include <climits>
+  #include <cstdint>
+  #include <cstdlib>
+  #include <sched.h>
+  #include <unistd.h>
+  #include <sys/stat.h>
+  #include <sys/syscall.h>
+  #include <sys/sysmacros.h>
+#endif
+
+namespace Burst
+{
+	namespace NumaHelper
+	{
+		struct Node
+		{
+			int id;
+			std::vector<int> cpus;
+		};
+
+		// parses a list of the sysfs like "0-3,8,10-11"
+		std::vector<int> parseList(const std::string& list)
+		{
+			std::vector<int> values;
+			const Poco::StringTokenizer ranges{list, ",", Poco::StringTokenizer::TOK_TRIM | Poco::StringTokenizer::TOK_IGNORE_EMPTY};
+
+			for (const auto& range : ranges)
+			{
+				const auto dash = range.find('-');
+				int first, last;
+
+				if (dash == std::string::npos)
+				{
+					if (!Poco::NumberParser::tryParse(range, first))
+						continue;
+
+					last = first;
+				}
+				else if (!Poco::NumberParser::tryParse(range.substr(0, dash), first) ||
+					!Poco::NumberParser::tryParse(range.substr(dash + 1), last))
+					continue;
+
+				for (auto i = first; i <= last; ++i)
+					values.emplace_back(i);
+			}
+
+			return values;
+		}
+
+		std::string readLine(const std::string& path)
+		{
+			std::ifstream file{path};
+			std::string line;
+			std::getline(file, line);
+			return line;
+		}
+
+		const std::vector<Node>& getNodes()
+		{
+			static const auto nodes = []()
+			{
+				std::vector<Node> nodes;
+#ifdef __linux__
+				for (const auto id : parseList(readLine("/sys/devices/system/node/online")))
+				{
+					auto cpus = parseList(readLine("/sys/devices/system/node/node" + std::to_string(id) + "/cpulist"));
+
+					// nodes with only memory have no CPUs for the workers
+					if (!cpus.empty())
+						nodes.push_back({id, std::move(cpus)});
+				}
+#endif
+				return nodes;
+			}();
+
+			return nodes;
+		}
+
+		size_t findNode(const std::string& path)
+		{
+#ifdef __linux__
+			struct stat status;
+
+			if (stat(path.c_str(), &status) != 0)
+				return 0;
+
+			// a raw BFS device is the device itself, a plot dir is on one
+			const auto device = S_ISBLK(status.st_mode) ? status.st_rdev : status.st_dev;
+			const auto link = "/sys/dev/block/" + std::to_string(major(device)) + ":" + std::to_string(minor(device));
+			char sysPath[PATH_MAX];
+
+			if (realpath(link.c_str(), sysPath) == nullptr)
+				return 0;
+
+			// walk up from the block device to its controller, the first one that knows its node decides
+			for (std::string dir = sysPath; dir.find("/sys/devices/") == 0; dir = dir.substr(0, dir.rfind('/')))
+			{
+				int id;
+
+				if (!Poco::NumberParser::tryParse(readLine(dir + "/numa_node"), id) || id < 0)
+					continue;
+
+				const auto& nodes = getNodes();
+
+				for (size_t i = 0; i < nodes.size(); ++i)
+					if (nodes[i].id == id)
+						return i;
+
+				return 0;
+			}
+#endif
+			return 0;
+		}
+
+		Poco::FastMutex pathsMutex;
+		std::unordered_map<std::string, size_t> paths;
+		thread_local size_t pinnedNode = std::numeric_limits<size_t>::max();
+	}
+}
+
+size_t Burst::Numa::getNodeCount()
+{
+	return std::max<size_t>(NumaHelper::getNodes().size(), 1);
+}
+
+bool Burst::Numa::isActive()
+{
+	return getNodeCount() > 1;
+}
+
+size_t Burst::Numa::getNodeOfPath(const std::string& path)
+{
+	if (!isActive())
+		return 0;
+
+	Poco::ScopedLock<Poco::FastMutex> lock{NumaHelper::pathsMutex};
+	const auto iter = NumaHelper::paths.find(path);
+
+	if (iter != NumaHelper::paths.end())
+		return iter->second;
+
+	const auto node = NumaHelper::findNode(path);
+	NumaHelper::paths.emplace(path, node);
+	return node;
+}
+
+void Burst::Numa::pinThread(const size_t node)
+{
+	if (!isActive() || node >= getNodeCount() || NumaHelper::pinnedNode == node)
+		return;
+
+#ifdef __linux__
+	cpu_set_t cpus;
+	CPU_ZERO(&cpus);
+
+	for (const auto cpu : NumaHelper::getNodes()[node].cpus)
+		if (cpu < CPU_SETSIZE)
+			CPU_SET(cpu, &cpus);
+
+	if (sched_setaffinity(0, sizeof cpus, &cpus) == 0)
+		NumaHelper::pinnedNode = node;
+#endif
+}
+
+void Burst::Numa::bindMemory(void* memory, const size_t size, const size_t node)
+{
+	if (!isActive() || node >= getNodeCount() || memory == nullptr)
+		return;
+
+#ifdef __linux__
+	// only whole pages can be bound
+	const auto pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+	const auto begin = (reinterpret_cast<uintptr_t>(memory) + pageSize - 1) / pageSize * pageSize;
+	const auto end = (reinterpret_cast<uintptr_t>(memory) + size) / pageSize * pageSize;
+
+	if (end <= begin)
+		return;
+
+	const auto id = static_cast<size_t>(NumaHelper::getNodes()[node].id);
+	constexpr auto bits = sizeof(unsigned long) * CHAR_BIT;
+	std::vector<unsigned long> mask(id / bits + 1);
+	mask[id / bits] |= 1UL << id % bits;
+
+	// preferred and not bound, so a full node still gives its pages from another one;
+	// pages already in memory stay where they are
+	constexpr auto mpolPreferred = 1;
+	syscall(SYS_mbind, begin, end - begin, mpolPreferred, mask.data(), mask.size() * bits + 1, 0);
+#endif
+}
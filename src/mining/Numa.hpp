@@ -0,0 +1,70 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace Burst
+{
+	/**
+	 * \brief The NUMA nodes of the machine and the helpers to keep the buffers and the workers on them.
+	 * On a machine with only one node, and on other systems than Linux, everything belongs
+	 * to node 0 and nothing is pinned or bound.
+	 */
+	class Numa
+	{
+	public:
+		/**
+		 * \brief The amount of nodes, at least 1.
+		 */
+		static size_t getNodeCount();
+
+		/**
+		 * \brief Checks, if the machine has more than one node.
+		 */
+		static bool isActive();
+
+		/**
+		 * \brief Gets the node nearest to the controller of the device, a path is stored on.
+		 * The result is cached per path.
+		 * \param path A file, a directory or a block device.
+		 * \return The index of the node, 0 if it is not known.
+		 */
+		static size_t getNodeOfPath(const std::string& path);
+
+		/**
+		 * \brief Restricts the calling thread to the CPUs of a node.
+		 * A thread that is already pinned to the node is not pinned again.
+		 * \param node The index of the node.
+		 */
+		static void pinThread(size_t node);
+
+		/**
+		 * \brief Lets the pages of a buffer, that are not yet in memory, be placed on a node.
+		 * \param memory The begin of the buffer.
+		 * \param size The size of the buffer in bytes.
+		 * \param node The index of the node.
+		 */
+		static void bindMemory(void* memory, size_t size, size_t node);
+	};
+}
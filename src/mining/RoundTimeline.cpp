@@ -0,0 +1,170 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "RoundTimeline.hpp"
+#include "plots/PlotReader.hpp"
+#include <Poco/NotificationQueue.h>
+#include <Poco/JSON/Array.h>
+#include <algorithm>
+
+void Burst::RoundTimeline::attachQueues(const Poco::NotificationQueue* readQueue,
+                                       const std::vector<Poco::NotificationQueue*>* verifyQueues)
+{
+	readQueue_ = readQueue;
+	verifyQueues_ = verifyQueues;
+}
+
+Burst::RoundTimeline::Event Burst::RoundTimeline::createEvent(const Stage stage, const std::string& label,
+                                                              const Poco::Timestamp& time) const
+{
+	const auto readQueue = readQueue_.load();
+	const auto verifyQueues = verifyQueues_.load();
+	auto verifyQueueSize = 0;
+
+	if (verifyQueues != nullptr)
+		for (const auto verifyQueue : *verifyQueues)
+			verifyQueueSize += verifyQueue->size();
+
+	return {
+		stage, time, label,
+		readQueue == nullptr ? 0 : readQueue->size(),
+		verifyQueueSize,
+		PlotReader::globalBufferSize.getSize()
+	};
+}
+
+void Burst::RoundTimeline::record(const Stage stage, const std::string& label, const Poco::Timestamp& time)
+{
+	auto event = createEvent(stage, label, time);
+	recorded_[static_cast<size_t>(stage)] = true;
+
+	Poco::ScopedLock<Poco::FastMutex> lock{mutex_};
+	events_.emplace_back(std::move(event));
+}
+
+void Burst::RoundTimeline::recordOnce(const Stage stage)
+{
+	// cheap check for the hot paths, only the first caller records the event
+	if (recorded_[static_cast<size_t>(stage)].exchange(true))
+		return;
+
+	record(stage);
+}
+
+void Burst::RoundTimeline::recordLast(const Stage stage)
+{
+	const auto index = static_cast<size_t>(stage);
+	const auto now = Poco::Timestamp().epochMicroseconds();
+	auto last = lastTime_[index].load();
+
+	recorded_[index] = true;
+	++lastCount_[index];
+
+	// only a later time replaces the remembered one
+	while (last < now && !lastTime_[index].compare_exchange_weak(last, now))
+	{
+	}
+}
+
+void Burst::RoundTimeline::snapshotLast()
+{
+	for (size_t i = 0; i < stageCount; ++i)
+	{
+		const auto time = lastTime_[i].exchange(0);
+		const auto count = lastCount_[i].exchange(0);
+
+		if (time == 0)
+			continue;
+
+		auto event = createEvent(static_cast<Stage>(i), std::to_string(count), Poco::Timestamp{time});
+
+		Poco::ScopedLock<Poco::FastMutex> lock{mutex_};
+		events_.emplace_back(std::move(event));
+	}
+}
+
+std::vector<Burst::RoundTimeline::Event> Burst::RoundTimeline::getEvents() const
+{
+	std::vector<Event> events;
+
+	{
+		Poco::ScopedLock<Poco::FastMutex> lock{mutex_};
+		events = events_;
+	}
+
+	for (size_t i = 0; i < stageCount; ++i)
+	{
+		const auto time = lastTime_[i].load();
+
+		if (time != 0)
+			events.emplace_back(createEvent(static_cast<Stage>(i), std::to_string(lastCount_[i].load()), Poco::Timestamp{time}));
+	}
+
+	return events;
+}
+
+Poco::JSON::Object Burst::RoundTimeline::toJSON(const Poco::UInt64 blockheight) const
+{
+	auto events = getEvents();
+
+	std::stable_sort(events.begin(), events.end(), [](const Event& lhs, const Event& rhs)
+	{
+		return lhs.time < rhs.time;
+	});
+
+	Poco::JSON::Object json;
+	Poco::JSON::Array jsonEvents;
+
+	json.set("type", "round timeline");
+	json.set("blockheight", blockheight);
+
+	for (const auto& event : events)
+	{
+		Poco::JSON::Object jsonEvent;
+		jsonEvent.set("stage", stageToString(event.stage));
+		jsonEvent.set("time", (event.time - events.front().time) / 1000);
+		jsonEvent.set("label", event.label);
+		jsonEvent.set("readQueue", event.readQueueSize);
+		jsonEvent.set("verifyQueue", event.verifyQueueSize);
+		jsonEvent.set("bufferUsed", event.bufferUsed);
+		jsonEvents.add(jsonEvent);
+	}
+
+	json.set("events", jsonEvents);
+	return json;
+}
+
+std::string Burst::RoundTimeline::stageToString(const Stage stage)
+{
+	switch (stage)
+	{
+	case Stage::GensigDetected: return "gensig detected";
+	case Stage::GensigUpdated: return "gensig updated";
+	case Stage::FirstChunkDequeued: return "first chunk dequeued";
+	case Stage::FirstChunkVerified: return "first chunk verified";
+	case Stage::FileFinished: return "file finished";
+	case Stage::DirFinished: return "dir finished";
+	case Stage::LastVerification: return "last verification";
+	case Stage::FirstDeadlineFound: return "first deadline found";
+	case Stage::SubmissionAck: return "submission ack";
+	default: return "";
+	}
+}
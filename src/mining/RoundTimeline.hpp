@@ -0,0 +1,132 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <Poco/Timestamp.h>
+#include <Poco/Mutex.h>
+#include <Poco/JSON/Object.h>
+
+namespace Poco
+{
+	class NotificationQueue;
+}
+
+namespace Burst
+{
+	/**
+	 * \brief Records the critical path of a mining round.
+	 * Every stage of the round (new gensig, reading, verifying, submitting) is recorded
+	 * together with the depths of the work queues and the occupancy of the buffer pool,
+	 * so it can be seen afterwards what dominated the round.
+	 */
+	class RoundTimeline
+	{
+	public:
+		enum class Stage
+		{
+			GensigDetected,
+			GensigUpdated,
+			FirstChunkDequeued,
+			FirstChunkVerified,
+			FileFinished,
+			DirFinished,
+			LastVerification,
+			FirstDeadlineFound,
+			SubmissionAck
+		};
+
+		struct Event
+		{
+			Stage stage;
+			Poco::Timestamp time;
+			std::string label;
+			int readQueueSize;
+			int verifyQueueSize;
+			Poco::UInt64 bufferUsed;
+		};
+
+		/**
+		 * \brief Sets the queues, whose sizes are recorded with every event.
+		 * \param readQueue The queue of the plot readers.
+		 * \param verifyQueues The queues of the plot verifiers, one per NUMA node.
+		 */
+		void attachQueues(const Poco::NotificationQueue* readQueue, const std::vector<Poco::NotificationQueue*>* verifyQueues);
+
+		/**
+		 * \brief Records an event.
+		 * \param stage The stage of the round.
+		 * \param label An additional description (reader, file, dir...).
+		 * \param time The time of the event, now by default.
+		 */
+		void record(Stage stage, const std::string& label = "", const Poco::Timestamp& time = {});
+
+		/**
+		 * \brief Records an event only the first time the stage is reached.
+		 * \param stage The stage of the round.
+		 */
+		void recordOnce(Stage stage);
+
+		/**
+		 * \brief Counts a stage and remembers the time of its latest occurrence, without a lock.
+		 * All occurrences become one event, with their amount as label.
+		 * \param stage The stage of the round.
+		 */
+		void recordLast(Stage stage);
+
+		/**
+		 * \brief Turns the counted stages into events, called once at the end of the round.
+		 */
+		void snapshotLast();
+
+		/**
+		 * \brief Gets all events, the counted stages that are not snapshotted yet included.
+		 */
+		std::vector<Event> getEvents() const;
+
+		/**
+		 * \brief Creates a JSON object of all events.
+		 * The time of every event is relative to the first event of the round in milliseconds.
+		 * \param blockheight The height of the round.
+		 * \return The JSON object with the type "round timeline".
+		 */
+		Poco::JSON::Object toJSON(Poco::UInt64 blockheight) const;
+
+		static std::string stageToString(Stage stage);
+
+	private:
+		Event createEvent(Stage stage, const std::string& label, const Poco::Timestamp& time) const;
+
+		static constexpr size_t stageCount = static_cast<size_t>(Stage::SubmissionAck) + 1;
+
+		std::vector<Event> events_;
+		std::array<std::atomic<bool>, stageCount> recorded_{};
+		std::array<std::atomic<Poco::Timestamp::TimeVal>, stageCount> lastTime_{};
+		std::array<std::atomic<Poco::UInt64>, stageCount> lastCount_{};
+		std::atomic<const Poco::NotificationQueue*> readQueue_{nullptr};
+		std::atomic<const std::vector<Poco::NotificationQueue*>*> verifyQueues_{nullptr};
+		mutable Poco::FastMutex mutex_;
+	};
+}
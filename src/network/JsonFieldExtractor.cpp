@@ -0,0 +1,244 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "JsonFieldExtractor.hpp"
+#include <cstring>
+#include <limits>
+
+namespace
+{
+	const char* skipWhitespace(const char* pos, const char* end)
+	{
+		while (pos != end && (*pos == ' ' || *pos == '\t' || *pos == '\r' || *pos == '\n'))
+			++pos;
+
+		return pos;
+	}
+
+	// pos points behind the opening quote, the returned position points to the closing quote
+	const char* skipString(const char* pos, const char* end, bool& escaped)
+	{
+		while (pos != end && *pos != '"')
+		{
+			if (*pos == '\\')
+			{
+				escaped = true;
+
+				if (++pos == end)
+					return end;
+			}
+
+			++pos;
+		}
+
+		return pos;
+	}
+
+	// pos points to the opening bracket, the returned position points behind the closing bracket
+	const char* skipNested(const char* pos, const char* end)
+	{
+		size_t depth = 0;
+
+		while (pos != end)
+		{
+			if (*pos == '"')
+			{
+				auto escaped = false;
+				pos = skipString(pos + 1, end, escaped);
+
+				if (pos == end)
+					return end;
+			}
+			else if (*pos == '{' || *pos == '[')
+				++depth;
+			else if ((*pos == '}' || *pos == ']') && --depth == 0)
+				return pos + 1;
+
+			++pos;
+		}
+
+		return end;
+	}
+}
+
+Burst::JsonFieldExtractor::JsonFieldExtractor(const std::string& json)
+{
+	valid_ = scan(json.data(), json.data() + json.size());
+}
+
+bool Burst::JsonFieldExtractor::scan(const char* begin, const char* end)
+{
+	auto pos = skipWhitespace(begin, end);
+
+	if (pos == end || *pos != '{')
+		return false;
+
+	pos = skipWhitespace(pos + 1, end);
+
+	if (pos != end && *pos == '}')
+		return skipWhitespace(pos + 1, end) == end;
+
+	while (pos != end)
+	{
+		if (size_ == maxFields || *pos != '"')
+			return false;
+
+		auto& field = fields_[size_];
+		auto escaped = false;
+
+		// the key
+		field.key = pos + 1;
+		pos = skipString(field.key, end, escaped);
+
+		if (pos == end || escaped)
+			return false;
+
+		field.keySize = static_cast<size_t>(pos - field.key);
+		pos = skipWhitespace(pos + 1, end);
+
+		if (pos == end || *pos != ':')
+			return false;
+
+		pos = skipWhitespace(pos + 1, end);
+
+		if (pos == end)
+			return false;
+
+		// the value
+		if (*pos == '"')
+		{
+			field.value = pos + 1;
+			field.isString = true;
+			field.isEscaped = false;
+			pos = skipString(field.value, end, field.isEscaped);
+
+			if (pos == end)
+				return false;
+
+			field.valueSize = static_cast<size_t>(pos - field.value);
+			++pos;
+		}
+		else if (*pos == '{' || *pos == '[')
+		{
+			field.value = pos;
+			field.isString = false;
+			field.isEscaped = false;
+			pos = skipNested(pos, end);
+			field.valueSize = static_cast<size_t>(pos - field.value);
+		}
+		else
+		{
+			field.value = pos;
+			field.isString = false;
+			field.isEscaped = false;
+
+			while (pos != end && *pos != ',' && *pos != '}' && *pos != ' ' && *pos != '\t' && *pos != '\r' && *pos != '\n')
+				++pos;
+
+			field.valueSize = static_cast<size_t>(pos - field.value);
+		}
+
+		++size_;
+		pos = skipWhitespace(pos, end);
+
+		if (pos == end)
+			return false;
+
+		if (*pos == '}')
+			return skipWhitespace(pos + 1, end) == end;
+
+		if (*pos != ',')
+			return false;
+
+		pos = skipWhitespace(pos + 1, end);
+	}
+
+	return false;
+}
+
+const Burst::JsonFieldExtractor::Field* Burst::JsonFieldExtractor::find(const char* key) const
+{
+	if (!valid_)
+		return nullptr;
+
+	const auto keySize = std::strlen(key);
+
+	for (size_t i = 0; i < size_; ++i)
+		if (fields_[i].keySize == keySize && std::memcmp(fields_[i].key, key, keySize) == 0)
+			return &fields_[i];
+
+	return nullptr;
+}
+
+bool Burst::JsonFieldExtractor::isValid() const
+{
+	return valid_;
+}
+
+bool Burst::JsonFieldExtractor::has(const char* key) const
+{
+	return find(key) != nullptr;
+}
+
+bool Burst::JsonFieldExtractor::isNull(const char* key) const
+{
+	const auto field = find(key);
+	return field != nullptr && !field->isString && field->valueSize == 4 && std::memcmp(field->value, "null", 4) == 0;
+}
+
+bool Burst::JsonFieldExtractor::getString(const char* key, std::string& value) const
+{
+	const auto field = find(key);
+
+	if (field == nullptr || !field->isString || field->isEscaped)
+		return false;
+
+	value.assign(field->value, field->valueSize);
+	return true;
+}
+
+bool Burst::JsonFieldExtractor::getUnsigned(const char* key, Poco::UInt64& value) const
+{
+	const auto field = find(key);
+
+	if (field == nullptr || field->valueSize == 0 || field->isEscaped)
+		return false;
+
+	Poco::UInt64 number = 0;
+
+	for (size_t i = 0; i < field->valueSize; ++i)
+	{
+		const auto c = field->value[i];
+
+		if (c < '0' || c > '9')
+			return false;
+
+		const auto digit = static_cast<Poco::UInt64>(c - '0');
+
+		if (number > (std::numeric_limits<Poco::UInt64>::max() - digit) / 10)
+			return false;
+
+		number = number * 10 + digit;
+	}
+
+	value = number;
+	return true;
+}
@@ -0,0 +1,105 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <string>
+#include <array>
+#include <Poco/Types.h>
+
+namespace Burst
+{
+	/**
+	 * \brief Extracts the top level fields of a flat JSON object without allocating memory.
+	 * The pool and wallet responses we are interested in (mining info, nonce confirmations)
+	 * have a small and fixed schema, so building a full JSON tree for them is not necessary.
+	 * The extractor only references the original data, so it must not outlive it.
+	 * If the data looks different than expected (escaped strings, too many fields, invalid syntax),
+	 * the extractor is marked as invalid and the caller should fall back to Poco::JSON::Parser.
+	 */
+	class JsonFieldExtractor
+	{
+	public:
+		/**
+		 * \brief Constructor.
+		 * Scans the JSON object once and remembers the position of every top level field.
+		 * \param json The JSON object. Leading whitespace is ignored.
+		 */
+		explicit JsonFieldExtractor(const std::string& json);
+
+		/**
+		 * \brief Returns, if the JSON object could be scanned completely.
+		 * \return true, if the data is a valid flat JSON object, false otherwise.
+		 */
+		bool isValid() const;
+
+		/**
+		 * \brief Returns, if a top level field exists.
+		 * \param key The name of the field.
+		 * \return true, if the field exists, false otherwise.
+		 */
+		bool has(const char* key) const;
+
+		/**
+		 * \brief Returns, if a top level field exists and is null.
+		 * \param key The name of the field.
+		 * \return true, if the field is null, false otherwise.
+		 */
+		bool isNull(const char* key) const;
+
+		/**
+		 * \brief Copies the value of a string field.
+		 * \param key The name of the field.
+		 * \param value The value of the field. Only changed, if the function returns true.
+		 * \return true, if the field exists and is a string without escape sequences, false otherwise.
+		 */
+		bool getString(const char* key, std::string& value) const;
+
+		/**
+		 * \brief Returns the value of an unsigned number field.
+		 * Pools and wallets send numbers sometimes as strings, so both representations are accepted.
+		 * \param key The name of the field.
+		 * \param value The value of the field. Only changed, if the function returns true.
+		 * \return true, if the field exists and holds an unsigned 64 bit number, false otherwise.
+		 */
+		bool getUnsigned(const char* key, Poco::UInt64& value) const;
+
+	private:
+		struct Field
+		{
+			const char* key;
+			size_t keySize;
+			const char* value;
+			size_t valueSize;
+			bool isString;
+			bool isEscaped;
+		};
+
+		const Field* find(const char* key) const;
+		bool scan(const char* begin, const char* end);
+
+		static constexpr size_t maxFields = 16;
+
+		std::array<Field, maxFields> fields_;
+		size_t size_ = 0;
+		bool valid_ = false;
+	};
+}
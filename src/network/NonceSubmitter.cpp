@@ -30,6 +30,29 @@
 #include <chrono>
 #include <thread>
 #include <Poco/JSON/Parser.h>
+#include "logging/Metrics.hpp"
+#include "logging/Tracing.hpp"
+
+namespace Burst
+{
+	namespace NonceSubmitterHelper
+	{
+		std::string outcomeToString(const SubmitResponse response)
+		{
+			switch (response)
+			{
+			case SubmitResponse::Confirmed: return "confirmed";
+			case SubmitResponse::Submitted: return "submitted";
+			case SubmitResponse::NotBest: return "not_best";
+			case SubmitResponse::TooHigh: return "too_high";
+			case SubmitResponse::WrongBlock: return "wrong_block";
+			case SubmitResponse::Error: return "error";
+			case SubmitResponse::Found: return "found";
+			default: return "none";
+			}
+		}
+	}
+}
 
 Burst::NonceSubmitter::NonceSubmitter(Miner& miner, const std::shared_ptr<Deadline>& deadline)
 	: Task(serializeDeadline(*deadline)),
@@ -117,6 +140,9 @@ Burst::NonceConfirmation Burst::NonceSubmitter::submit(const std::shared_ptr<Dea
 	while (loopConditionHelper(submitTryCount, submissionMaxRetry, &urlIter))
 	{
 		NonceRequest request{MinerConfig::getConfig().createSession(*urlIter)};
+		const auto pool = urlIter->getCanonical();
+		Poco::Timestamp submitStart;
+		TraceSpan submitSpan{"submit nonce", "submitter"};
 
 		auto response = request.submit(*deadline);
 		auto receiveTryCount = 0u;
@@ -147,6 +173,13 @@ Burst::NonceConfirmation Burst::NonceSubmitter::submit(const std::shared_ptr<Dea
 				urlIter->getCanonical(), submitTryCount, submissionMaxRetry)));
 		}
 
+		submitSpan.end();
+
+		Metrics::histogram("creepminer_submission_seconds", "Time to submit a nonce and receive the answer",
+		                   {{"pool", pool}}, Metrics::latencyBounds(), 1e-6).observe(submitStart.elapsed());
+		Metrics::counter("creepminer_submissions_total", "Submission attempts by pool and outcome",
+		                 {{"pool", pool}, {"outcome", NonceSubmitterHelper::outcomeToString(confirmation.errorCode)}}).add();
+
 		++submitTryCount;
 		
 		if (confirmation.errorCode != SubmitResponse::Confirmed &&
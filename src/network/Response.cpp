@@ -22,10 +22,12 @@
 #include <Poco/JSON/Parser.h>
 #include <Poco/NestedDiagnosticContext.h>
 #include "Response.hpp"
+#include "JsonFieldExtractor.hpp"
 #include "MinerUtil.hpp"
 #include "logging/MinerLogger.hpp"
 #include "Poco/Net/HTTPClientSession.h"
 #include "Poco/Net/HTTPResponse.h"
+#include <Poco/StreamCopier.h>
 
 using namespace Poco::Net;
 
@@ -60,8 +62,19 @@ bool Burst::Response::receive(std::string& data, int& status) const
 	try
 	{
 		HTTPResponse response;
-		const auto responseStream = &session_->receiveResponse(response);
-		data = {std::istreambuf_iterator<char>(*responseStream), {}};
+		auto& responseStream = session_->receiveResponse(response);
+		data.clear();
+
+		// with a known length the body is read in one go straight into the string
+		if (response.hasContentLength())
+		{
+			data.resize(static_cast<size_t>(response.getContentLength64()));
+			responseStream.read(&data[0], static_cast<std::streamsize>(data.size()));
+			data.resize(static_cast<size_t>(responseStream.gcount()));
+		}
+		else
+			Poco::StreamCopier::copyToString(responseStream, data);
+
 		status = response.getStatus();
 		return status == HTTPResponse::HTTP_OK;
 	}
@@ -184,6 +197,16 @@ Burst::NonceConfirmation Burst::NonceResponse::getConfirmation() const
 
 	if (response_.receive(response, status))
 	{
+		// fast path for the usual confirmation, that only needs the deadline
+		const JsonFieldExtractor extractor{response};
+
+		if (extractor.getUnsigned("deadline", confirmation.deadline))
+		{
+			confirmation.json = response;
+			confirmation.errorCode = SubmitResponse::Confirmed;
+			return confirmation;
+		}
+
 		try
 		{
 			Poco::JSON::Parser parser;
@@ -0,0 +1,145 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "DiskHealth.hpp"
+#include <Poco/JSON/Object.h>
+#include "mining/Numa.hpp"
+#include <vector>
+
+namespace Burst
+{
+	namespace DiskHealthHelper
+	{
+		// weight of the newest round in the baseline
+		constexpr auto baselineWeight = 0.1;
+		// rounds needed before a baseline is trusted
+		constexpr Poco::UInt64 minRounds = 5;
+		// a device is slow, if it reads with less than this share of its baseline
+		constexpr auto slowShare = 0.6;
+	}
+}
+
+double Burst::ReadThroughput::getBytesPerSecond() const
+{
+	if (duration == 0)
+		return 0;
+
+	return static_cast<double>(bytes) * 1000 * 1000 / duration;
+}
+
+bool Burst::DiskHealth::update(const std::string& device, const double bytesPerSecond, const Poco::UInt64 blockheight)
+{
+	using namespace DiskHealthHelper;
+
+	if (bytesPerSecond <= 0)
+		return false;
+
+	Poco::ScopedLock<Poco::FastMutex> lock{mutex_};
+	auto& state = devices_[device];
+	const auto wasSlow = state.slow;
+
+	state.slow = state.rounds >= minRounds && bytesPerSecond < state.baseline * slowShare;
+	state.last = bytesPerSecond;
+	state.lastHeight = blockheight;
+
+	if (state.rounds == 0)
+		state.baseline = bytesPerSecond;
+	else
+		state.baseline = state.baseline * (1 - baselineWeight) + bytesPerSecond * baselineWeight;
+
+	++state.rounds;
+	return state.slow && !wasSlow;
+}
+
+bool Burst::DiskHealth::get(const std::string& device, Device& state) const
+{
+	Poco::ScopedLock<Poco::FastMutex> lock{mutex_};
+	const auto iter = devices_.find(device);
+
+	if (iter == devices_.end())
+		return false;
+
+	state = iter->second;
+	return true;
+}
+
+Poco::JSON::Array Burst::DiskHealth::toJSON() const
+{
+	std::unordered_map<std::string, Device> devices;
+
+	// the node of a device is looked up outside the lock, it could stat the device
+	{
+		Poco::ScopedLock<Poco::FastMutex> lock{mutex_};
+		devices = devices_;
+	}
+
+	Poco::JSON::Array json;
+
+	for (const auto& device : devices)
+	{
+		Poco::JSON::Object jsonDevice;
+		jsonDevice.set("device", device.first);
+		jsonDevice.set("baseline", static_cast<Poco::UInt64>(device.second.baseline));
+		jsonDevice.set("last", static_cast<Poco::UInt64>(device.second.last));
+		jsonDevice.set("rounds", device.second.rounds);
+		jsonDevice.set("lastHeight", device.second.lastHeight);
+		jsonDevice.set("slow", device.second.slow);
+
+		if (Numa::isActive())
+			jsonDevice.set("node", Numa::getNodeOfPath(device.first));
+
+		json.add(jsonDevice);
+	}
+
+	return json;
+}
+
+Poco::JSON::Array Burst::DiskHealth::nodesToJSON() const
+{
+	std::unordered_map<std::string, Device> devices;
+	std::vector<Device> nodes(Numa::getNodeCount());
+
+	// the node of a device is looked up outside the lock, it could stat the device
+	{
+		Poco::ScopedLock<Poco::FastMutex> lock{mutex_};
+		devices = devices_;
+	}
+
+	for (const auto& device : devices)
+	{
+		auto& node = nodes[Numa::getNodeOfPath(device.first)];
+		node.baseline += device.second.baseline;
+		node.last += device.second.last;
+	}
+
+	Poco::JSON::Array json;
+
+	for (size_t i = 0; i < nodes.size(); ++i)
+	{
+		Poco::JSON::Object jsonNode;
+		jsonNode.set("node", i);
+		jsonNode.set("baseline", static_cast<Poco::UInt64>(nodes[i].baseline));
+		jsonNode.set("last", static_cast<Poco::UInt64>(nodes[i].last));
+		json.add(jsonNode);
+	}
+
+	return json;
+}
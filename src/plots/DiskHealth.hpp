@@ -0,0 +1,83 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/Types.h>
+#include <Poco/Mutex.h>
+#include <Poco/JSON/Array.h>
+#include <string>
+#include <unordered_map>
+
+namespace Burst
+{
+	/**
+	 * \brief The read throughput of a plot file or a whole plot dir (device) in one round.
+	 * The file is empty for the device total.
+	 */
+	struct ReadThroughput
+	{
+		std::string device;
+		std::string file;
+		Poco::UInt64 bytes;
+		Poco::UInt64 duration;
+
+		double getBytesPerSecond() const;
+	};
+
+	/**
+	 * \brief Keeps a rolling baseline of the read throughput of every device
+	 * and flags the devices, that fall behind their baseline.
+	 */
+	class DiskHealth
+	{
+	public:
+		struct Device
+		{
+			double baseline = 0;
+			double last = 0;
+			Poco::UInt64 rounds = 0;
+			Poco::UInt64 lastHeight = 0;
+			bool slow = false;
+		};
+
+		/**
+		 * \brief Adds the throughput of a finished round.
+		 * \param device The plot dir.
+		 * \param bytesPerSecond The throughput in the round.
+		 * \param blockheight The height of the round.
+		 * \return true, if the device just became slow.
+		 */
+		bool update(const std::string& device, double bytesPerSecond, Poco::UInt64 blockheight);
+		bool get(const std::string& device, Device& state) const;
+		Poco::JSON::Array toJSON() const;
+
+		/**
+		 * \brief Sums the throughput of the devices per NUMA node.
+		 * \return One entry per node, with the throughput of the last rounds and the baselines.
+		 */
+		Poco::JSON::Array nodesToJSON() const;
+
+	private:
+		std::unordered_map<std::string, Device> devices_;
+		mutable Poco::FastMutex mutex_;
+	};
+}
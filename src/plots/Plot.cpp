@@ -194,6 +194,12 @@ Burst::PlotDir::Type Burst::PlotDir::getType() const
 	return type_;
 }
 
+void Burst::PlotDir::addRelatedDir(std::shared_ptr<PlotDir> relatedDir)
+{
+	relatedDirs_.emplace_back(std::move(relatedDir));
+	recalculateHash();
+}
+
 std::vector<std::shared_ptr<Burst::PlotDir>> Burst::PlotDir::getRelatedDirs() const
 {
 	return relatedDirs_;
@@ -207,6 +213,7 @@ const std::string& Burst::PlotDir::getHash() const
 void Burst::PlotDir::rescan()
 {
 	plotfiles_.clear();
+	plotfilesByPath_.clear();
 	size_ = 0;
 
 	addPlotLocation(path_);
@@ -308,13 +315,15 @@ std::shared_ptr<Burst::PlotFile> Burst::PlotDir::addPlotFile(const Poco::File& f
 	if (result == PlotCheckResult::Ok)
 	{
 		// plot file is already in our list
-		for (auto& plotfile : plotfiles_)
-			if (plotfile->getPath() == file.path())
-				return plotfile;
+		const auto iter = plotfilesByPath_.find(file.path());
+
+		if (iter != plotfilesByPath_.end())
+			return iter->second;
 
 		// make a new plotfile and add it to the list
 		auto plotFile = std::make_shared<PlotFile>(std::string(file.path()));
 		plotfiles_.emplace_back(plotFile);
+		plotfilesByPath_.emplace(file.path(), plotFile);
 		size_ += file.getSize();
 
 		return plotFile;
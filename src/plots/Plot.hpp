@@ -24,6 +24,8 @@
 #include <Poco/Types.h>
 #include <memory>
 #include <vector>
+#include <string>
+#include <unordered_map>
 
 namespace Poco {
 	class File;
@@ -180,6 +182,12 @@ namespace Burst
 		 */
 		PlotDir(std::string path, const std::vector<std::string>& relatedPaths, Type type);
 
+		/**
+		 * \brief Adds an already scanned plot directory as related directory.
+		 * \param relatedDir The related plot directory.
+		 */
+		void addRelatedDir(std::shared_ptr<PlotDir> relatedDir);
+
 		/**
 		* \brief Returns all plot files inside the directory.
 		* \param recursive If true, also all plot files in all related plot directories are gathered.
@@ -253,6 +261,8 @@ namespace Burst
 		Type type_;
 		Poco::UInt64 size_;
 		PlotList plotfiles_;
+		// the plot files by their path, to find duplicates without searching the list
+		std::unordered_map<std::string, std::shared_ptr<PlotFile>> plotfilesByPath_;
 		std::vector<std::shared_ptr<PlotDir>> relatedDirs_;
 		std::string hash_;
 	};
@@ -32,105 +32,348 @@
 #include "logging/Output.hpp"
 #include "Plot.hpp"
 #include <Poco/FileStream.h>
+#include "logging/Metrics.hpp"
+#include "logging/Tracing.hpp"
+#include "mining/Numa.hpp"
+#include <algorithm>
+#include <new>
 
 Burst::GlobalBufferSize Burst::PlotReader::globalBufferSize;
+Burst::RoundEpoch Burst::PlotReader::roundEpoch;
+
+Burst::GlobalBufferSize::~GlobalBufferSize()
+{
+	for (auto& pool : pools_)
+		for (const auto& buffer : pool.buffers)
+			delete[] static_cast<char*>(buffer.first);
+}
 
 void Burst::GlobalBufferSize::setMax(const Poco::UInt64 max)
 {
 	chunkQueue.wakeUpAll();
 
-	if (max > 0)
-	{
-		if (getMax() == max)
-			return;
+	if (max == 0)
+		return;
+
+	const auto chunks = MinerConfig::getConfig().getBufferChunkCount();
 
-		if (memoryPool_ != nullptr)
-			memoryPool_.reset();
+	Poco::FastMutex::ScopedLock lock{mutex_};
 
-		const auto chunks = MinerConfig::getConfig().getBufferChunkCount();
-		auto chunkSize = max / chunks;
+	if (max_ == max && chunks_ == chunks)
+		return;
+
+	const auto nodes = Numa::getNodeCount();
+
+	// the pools live as long as the miner, the readers and verifiers can use them while the limits change
+	if (pools_.size() != nodes)
+		pools_.resize(nodes);
+
+	chunkSize_ = max / chunks;
+
+	// the chunks are shared between the nodes, the remainder goes to the first nodes;
+	// a node without chunks takes its buffers from the other nodes
+	for (size_t node = 0; node < nodes; ++node)
+	{
+		auto& pool = pools_[node];
+		pool.maxBuffers = chunks / nodes + (node < chunks % nodes ? 1 : 0);
 
-		memoryPool_ = std::make_unique<Poco::MemoryPool>(chunkSize, 0, chunks);
-		max_ = max;
+		// the free buffers that do not fit anymore are given back, the used ones when they are released
+		for (auto free = pool.free.begin(); free != pool.free.end();)
+		{
+			if (pool.buffers[*free] != chunkSize_ || pool.buffers.size() > pool.maxBuffers)
+			{
+				deallocate(pool, *free);
+				free = pool.free.erase(free);
+			}
+			else
+				++free;
+		}
 	}
+
+	max_ = max;
+	chunks_ = chunks;
 }
 
-void* Burst::GlobalBufferSize::reserve()
+void* Burst::GlobalBufferSize::reserve(size_t& node)
 {
 	// unlimited memory
 	//if (MinerConfig::getConfig().getMaxBufferSizeRaw() == 0)
 	//	return true;
 
-	try
-	{
-		return memoryPool_->get();
-	}
-	catch (...)
+	Poco::FastMutex::ScopedLock lock{mutex_};
+
+	const auto pools = pools_.size();
+
+	if (node >= pools)
+		node = 0;
+
+	// first the pool of the node, then the others
+	for (size_t i = 0; i < pools; ++i)
 	{
-		return nullptr;
+		const auto poolNode = (node + i) % pools;
+		auto& pool = pools_[poolNode];
+		void* memory = nullptr;
+
+		if (!pool.free.empty())
+		{
+			memory = pool.free.back();
+			pool.free.pop_back();
+		}
+		else if (pool.buffers.size() < pool.maxBuffers)
+		{
+			memory = new (std::nothrow) char[chunkSize_];
+
+			if (memory == nullptr)
+				continue;
+
+			pool.buffers.emplace(memory, chunkSize_);
+			allocated_ += chunkSize_;
+
+			// a buffer is reused, so it is bound to the node only once, when it is allocated
+			Numa::bindMemory(memory, chunkSize_, poolNode);
+		}
+		else
+			continue;
+
+		node = poolNode;
+		return memory;
 	}
+
+	return nullptr;
 }
 
-void Burst::GlobalBufferSize::free(void* memory)
+void Burst::GlobalBufferSize::free(void* memory, const size_t node)
 {
 	// unlimited memory
 	//if (MinerConfig::getConfig().getMaxBufferSizeRaw() == 0)
 	//	return true;
 
-	memoryPool_->release(memory);
+	Poco::FastMutex::ScopedLock lock{mutex_};
+
+	auto& pool = pools_[node];
+
+	// a buffer of the old size or above the new limit is not reused
+	if (pool.buffers[memory] != chunkSize_ || pool.buffers.size() > pool.maxBuffers)
+		deallocate(pool, memory);
+	else
+		pool.free.push_back(memory);
 }
 
 Poco::UInt64 Burst::GlobalBufferSize::getSize() const
 {
-	if (memoryPool_ == nullptr)
-		return 0;
+	Poco::FastMutex::ScopedLock lock{mutex_};
+	return allocated_;
+}
 
-	return memoryPool_->blockSize() * memoryPool_->allocated();
+void Burst::GlobalBufferSize::deallocate(Pool& pool, void* memory)
+{
+	allocated_ -= pool.buffers[memory];
+	pool.buffers.erase(memory);
+	delete[] static_cast<char*>(memory);
 }
 
 Poco::UInt64 Burst::GlobalBufferSize::getMax() const
 {
+	Poco::FastMutex::ScopedLock lock{mutex_};
 	return max_;
 }
 
+void Burst::WorkerNotification::post(const unsigned count, Poco::NotificationQueue& queue)
+{
+	for (auto i = 0u; i < count; ++i)
+		queue.enqueueUrgentNotification(new WorkerNotification);
+}
+
+void Burst::WorkerRetirement::request(const unsigned count, Poco::NotificationQueue& queue)
+{
+	pending_ += count;
+	WorkerNotification::post(count, queue);
+}
+
+bool Burst::WorkerRetirement::tryRetire()
+{
+	auto pending = pending_.load();
+
+	while (pending > 0)
+		if (pending_.compare_exchange_weak(pending, pending - 1))
+			return true;
+
+	return false;
+}
+
+unsigned Burst::WorkerRetirement::withdraw()
+{
+	return pending_.exchange(0);
+}
+
+Burst::VerificationQueues::VerificationQueues(const size_t nodes)
+	: verifiers_(nodes, 0)
+{
+	for (size_t node = 0; node < nodes; ++node)
+	{
+		nodes_.emplace_back(std::make_unique<Poco::NotificationQueue>());
+		queues_.emplace_back(nodes_.back().get());
+	}
+}
+
+void Burst::VerificationQueues::enqueue(Poco::Notification::Ptr notification, const size_t node)
+{
+	Poco::ScopedReadRWLock lock{lock_};
+	queues_[getTarget(node % queues_.size())]->enqueueNotification(notification);
+}
+
+void Burst::VerificationQueues::setVerifiers(const std::vector<unsigned>& verifiers)
+{
+	Poco::ScopedWriteRWLock lock{lock_};
+
+	for (size_t node = 0; node < verifiers_.size() && node < verifiers.size(); ++node)
+		verifiers_[node] = verifiers[node];
+
+	for (size_t node = 0; node < queues_.size(); ++node)
+	{
+		const auto target = getTarget(node);
+
+		if (target == node)
+			continue;
+
+		// the retiring verifiers of the node still need their wake ups
+		auto& queue = *queues_[node];
+		unsigned wakeUps = 0;
+
+		for (Poco::Notification::Ptr notification(queue.dequeueNotification()); !notification.isNull();
+		     notification = queue.dequeueNotification())
+		{
+			if (dynamic_cast<WorkerNotification*>(notification.get()) != nullptr)
+				++wakeUps;
+			else
+				queues_[target]->enqueueNotification(notification);
+		}
+
+		WorkerNotification::post(wakeUps, queue);
+	}
+}
+
+Poco::NotificationQueue& Burst::VerificationQueues::getQueue(const size_t node)
+{
+	return *queues_[node];
+}
+
+const std::vector<Poco::NotificationQueue*>& Burst::VerificationQueues::getQueues() const
+{
+	return queues_;
+}
+
+size_t Burst::VerificationQueues::getTarget(const size_t node) const
+{
+	// without any verifiers the chunks wait on their own node
+	for (size_t i = 0; i < verifiers_.size(); ++i)
+		if (verifiers_[(node + i) % verifiers_.size()] > 0)
+			return (node + i) % verifiers_.size();
+
+	return node;
+}
+
+Poco::UInt64 Burst::RoundEpoch::next()
+{
+	return ++epoch_;
+}
+
+Poco::UInt64 Burst::RoundEpoch::get() const
+{
+	return epoch_.load();
+}
+
+bool Burst::RoundEpoch::isCurrent(const Poco::UInt64 epoch) const
+{
+	return epoch_.load(std::memory_order_relaxed) == epoch;
+}
+
 Burst::PlotReader::PlotReader(MinerData& data, std::shared_ptr<PlotReadProgress> progressRead,
                               std::shared_ptr<PlotReadProgress> progressVerify,
-                              Poco::NotificationQueue& verificationQueue, Poco::NotificationQueue& plotReadQueue)
+                              VerificationQueues& verificationQueues, Poco::NotificationQueue& plotReadQueue,
+                              WorkerRetirement& retirement)
 	: Task("PlotReader"), data_(data), progressRead_{std::move(progressRead)}, progressVerify_{std::move(progressVerify)},
-	  verificationQueue_{&verificationQueue},
-	  plotReadQueue_(&plotReadQueue)
+	  verificationQueues_{&verificationQueues},
+	  plotReadQueue_(&plotReadQueue),
+	  retirement_{&retirement}
 {
 }
 
 void Burst::PlotReader::runTask()
 {
 	ScoopData* memoryMirror = nullptr;
+	size_t mirrorNode = 0;
+	Poco::UInt64 timelineBlockheight = 0;
+
+	auto& bufferWait = Metrics::histogram("creepminer_buffer_wait_seconds", "Time a plot reader waited for a free buffer",
+	                                      {}, Metrics::latencyBounds(), 1e-6);
+	auto& staleChunks = Metrics::counter("creepminer_stale_chunks_dropped_total",
+	                                     "Chunks of an old round, that were dropped without verifying them", {{"stage", "reader"}});
+
+	const auto recordTimeline = [this](const Poco::UInt64 blockheight, const RoundTimeline::Stage stage, const std::string& label)
+	{
+		const auto block = data_.getBlockData();
+
+		if (block != nullptr && block->getBlockheight() == blockheight)
+			block->getTimeline().record(stage, label);
+	};
 
 	while (!isCancelled())
 	{
 		try
 		{
+			// the pool shrinks, we stop between two plot dirs
+			if (retirement_->tryRetire())
+				break;
+
+			TraceSpan waitSpan{"wait for plot dir", "reader"};
 			Poco::Notification::Ptr notification(plotReadQueue_->waitDequeueNotification());
 			PlotReadNotification::Ptr plotReadNotification;
+			waitSpan.end();
 
 			if (notification)
 				plotReadNotification = notification.cast<PlotReadNotification>();
-			else
-				break;
 
-			// only process the current block
-			if (data_.getCurrentBlockheight() != plotReadNotification->blockheight)
+			// woken up without work, check again if we are cancelled or retired
+			if (plotReadNotification.isNull())
+				continue;
+
+			// only process the current round
+			if (!roundEpoch.isCurrent(plotReadNotification->epoch))
 				continue;
 
-			auto poc2 = false;
+			// read on the node nearest to the disk, so the buffers are filled there
+			Numa::pinThread(plotReadNotification->node);
 
-			if (MinerConfig::getConfig().getPoc2StartBlock() > 0)
-				poc2 = MinerConfig::getConfig().getPoc2StartBlock() <= plotReadNotification->blockheight;
+			// every reader records only its first dequeued chunk of a round
+			if (!plotReadNotification->wakeUpCall && timelineBlockheight != plotReadNotification->blockheight)
+			{
+				timelineBlockheight = plotReadNotification->blockheight;
+				recordTimeline(timelineBlockheight, RoundTimeline::Stage::FirstChunkDequeued, plotReadNotification->dir);
+			}
+
+			auto& readLatency = Metrics::histogram("creepminer_plot_read_seconds", "Time to read one chunk of scoops",
+			                                       {{"device", plotReadNotification->dir}}, Metrics::latencyBounds(), 1e-6);
+			auto& readBytes = Metrics::counter("creepminer_plot_read_bytes_total", "Bytes read from the plot files",
+			                                   {{"device", plotReadNotification->dir}});
+
+			// the read bandwidth per NUMA node, only on machines with more than one
+			MetricCounter* nodeReadBytes = nullptr;
+
+			if (Numa::isActive())
+				nodeReadBytes = &Metrics::counter("creepminer_numa_read_bytes_total", "Bytes read from the disks nearest to a NUMA node",
+				                                  {{"node", std::to_string(plotReadNotification->node)}});
+
+			// one lock-free view of the settings for the whole notification
+			const auto config = MinerConfig::getConfig().getSnapshot();
+			const auto poc2 = config->isPoC2(plotReadNotification->blockheight);
 
 			Poco::Timestamp timeStartDir;
+			// only the time spent reading, waiting for buffers would let a slow verifier look like a slow disk
+			Poco::Timestamp::TimeDiff dirReadTime = 0;
 
 			// check, if the incoming plot-read-notification is for the current round
-			auto currentBlock = plotReadNotification->blockheight == data_.getCurrentBlockheight();
+			auto currentBlock = roundEpoch.isCurrent(plotReadNotification->epoch);
 			auto& plotList = plotReadNotification->plotList;
 
 			// put in all related plot files
@@ -155,6 +398,7 @@ void Burst::PlotReader::runTask()
 					progressVerify_, plotFile.getNonces(), plotReadNotification->blockheight);
 
 				Poco::Timestamp timeStartFile;
+				Poco::Timestamp::TimeDiff fileReadTime = 0;
 
 				if (!isCancelled() && inputStream)
 				{
@@ -172,11 +416,10 @@ void Burst::PlotReader::runTask()
 						break;
 					}
 
-					const auto maxBufferSize = MinerConfig::getConfig().getMaxBufferSizeRaw();
-					auto chunkBytes = MinerConfig::getConfig().getMaxBufferSize() / MinerConfig::getConfig().getBufferChunkCount();
+					auto chunkBytes = config->chunkBytes;
 
 					// unlimited buffer size
-					if (maxBufferSize == 0)
+					if (config->maxBufferSizeRaw == 0)
 						chunkBytes = plotFile.getStaggerScoopBytes();
 
 					const auto noncesPerChunk = std::min(chunkBytes / Settings::scoopSize, plotFile.getStaggerSize());
@@ -194,25 +437,42 @@ void Burst::PlotReader::runTask()
 
 						const auto memoryToAcquire = std::min(readNonces * Settings::scoopSize, chunkBytes);
 						ScoopData* memory = nullptr;
+						auto memoryNode = plotReadNotification->node;
+						Poco::Timestamp bufferWaitStart;
+						TraceSpan bufferSpan{"wait for buffer", "reader"};
 
-						while (!isCancelled() && memory == nullptr)
+						// a new round does not wait for the buffers of the old one
+						while (!isCancelled() && memory == nullptr && currentBlock)
 						{
-							memory = reinterpret_cast<ScoopData*>(globalBufferSize.reserve());
+							memoryNode = plotReadNotification->node;
+							memory = reinterpret_cast<ScoopData*>(globalBufferSize.reserve(memoryNode));
 
 							if (memory == nullptr)
 							{
 								std::this_thread::sleep_for(std::chrono::milliseconds{38});
+								currentBlock = roundEpoch.isCurrent(plotReadNotification->epoch);
 								continue;
 							}
 
 							if (poc2 && !plotFile.isPoC(2))
 							{
-								while (!isCancelled() && memoryMirror == nullptr)
+								while (!isCancelled() && memoryMirror == nullptr && currentBlock)
 								{
-									memoryMirror = reinterpret_cast<ScoopData*>(globalBufferSize.reserve());
+									mirrorNode = plotReadNotification->node;
+									memoryMirror = reinterpret_cast<ScoopData*>(globalBufferSize.reserve(mirrorNode));
 
 									if (memoryMirror == nullptr)
+									{
 										std::this_thread::sleep_for(std::chrono::milliseconds{38});
+										currentBlock = roundEpoch.isCurrent(plotReadNotification->epoch);
+									}
+								}
+
+								// the round is over, the new one needs the buffer that is already held
+								if (!currentBlock)
+								{
+									globalBufferSize.free(memory, memoryNode);
+									memory = nullptr;
 								}
 							}
 						}
@@ -222,16 +482,22 @@ void Burst::PlotReader::runTask()
 						{
 							// but first give free the allocated memory
 							if (memory != nullptr)
-								globalBufferSize.free(memory);
+								globalBufferSize.free(memory, memoryNode);
 
 							if (memoryMirror != nullptr)
-								globalBufferSize.free(memoryMirror);
+							{
+								globalBufferSize.free(memoryMirror, mirrorNode);
+								memoryMirror = nullptr;
+							}
 
 							continue;
 						}
 
 						if (memory != nullptr && currentBlock)
 						{
+							bufferWait.observe(bufferWaitStart.elapsed());
+							bufferSpan.end();
+
 							const auto chunkOffset = startNonce % plotFile.getStaggerSize() * Settings::scoopSize;
 							const auto staggerBlockOffset = staggerBegin * plotFile.getStaggerBytes();
 							const auto staggerScoopOffset = plotReadNotification->scoopNum * plotFile.getStaggerScoopBytes();
@@ -244,17 +510,21 @@ void Burst::PlotReader::runTask()
 							verification->gensig = plotReadNotification->gensig;
 							verification->nonceRead = startNonce;
 							verification->baseTarget = plotReadNotification->baseTarget;
+							verification->epoch = plotReadNotification->epoch;
+							verification->node = memoryNode;
 							verification->nonces = readNonces;
 							verification->buffer = memory;
 							verification->progress = progressGuardVerify;
 
 							const auto offset = startPos + staggerBlockOffset + staggerScoopOffset + chunkOffset;
+							Poco::Timestamp readStart;
+							TraceSpan readSpan{"read chunk", "reader"};
 
 							if (!inputStream.seekg(offset))
 							{
 								log_error(MinerLogger::plotReader, "Could not set the read position of '%s' to %Lu (nonce %Lu)",
 									plotFile.getPath(), offset, offset / Settings::plotSize);
-								globalBufferSize.free(memory);
+								globalBufferSize.free(memory, memoryNode);
 								break;
 							}
 
@@ -263,7 +533,7 @@ void Burst::PlotReader::runTask()
 								log_error(MinerLogger::plotReader,
 									"Could not read %Lu bytes (%Lu nonces) of '%s' at position %Lu (mirror nonce), file size is %Lu",
 									memoryToAcquire, memoryToAcquire / Settings::plotSize, plotFile.getPath(), offset, plotFile.getSize());
-								globalBufferSize.free(memory);
+								globalBufferSize.free(memory, memoryNode);
 								break;
 							}
 
@@ -276,7 +546,9 @@ void Burst::PlotReader::runTask()
 								{
 									log_error(MinerLogger::plotReader, "Could not set read position of %s to %Lu (mirror nonce %Lu)",
 										plotFile.getPath(), offsetMirror, offsetMirror / Settings::plotSize);
-									globalBufferSize.free(memoryMirror);
+									globalBufferSize.free(memory, memoryNode);
+									globalBufferSize.free(memoryMirror, mirrorNode);
+									memoryMirror = nullptr;
 									break;
 								}
 
@@ -285,32 +557,69 @@ void Burst::PlotReader::runTask()
 									log_error(MinerLogger::plotReader,
 										"Could not read %Lu bytes (%Lu nonces) of '%s' at position %Lu (mirror nonce), file size is %Lu",
 										memoryToAcquire, memoryToAcquire / Settings::plotSize, plotFile.getPath(), offsetMirror, plotFile.getSize());
-									globalBufferSize.free(memoryMirror);
+									globalBufferSize.free(memory, memoryNode);
+									globalBufferSize.free(memoryMirror, mirrorNode);
+									memoryMirror = nullptr;
 									break;
 								}
 
 								for (size_t i = 0; i < readNonces; ++i)
 									memcpy(&verification->buffer[i][32], &memoryMirror[i][32], 32);
 
-								globalBufferSize.free(memoryMirror);
+								globalBufferSize.free(memoryMirror, mirrorNode);
+								memoryMirror = nullptr;
+								readBytes.add(memoryToAcquire);
+
+								if (nodeReadBytes != nullptr)
+									nodeReadBytes->add(memoryToAcquire);
 							}
 
-							verificationQueue_->enqueueNotification(verification);
+							const auto readTime = readStart.elapsed();
+							readLatency.observe(readTime);
+							readSpan.end();
+							fileReadTime += readTime;
+							dirReadTime += readTime;
+							readBytes.add(memoryToAcquire);
+
+							if (nodeReadBytes != nullptr)
+								nodeReadBytes->add(memoryToAcquire);
 
 							// check, if the incoming plot-read-notification is for the current round
-							currentBlock = plotReadNotification->blockheight == data_.getCurrentBlockheight();
+							currentBlock = roundEpoch.isCurrent(plotReadNotification->epoch);
+
+							// a chunk of an old round is not verified, its buffer is free for the new round right away
+							if (currentBlock)
+							{
+								// the chunk is verified by the verifiers of the node its buffer is on, if it has some
+								verification->enqueued.update();
+								verificationQueues_->enqueue(verification, memoryNode);
+							}
+							else
+							{
+								globalBufferSize.free(memory, memoryNode);
+								staleChunks.add(1);
+							}
+
 							nonce += readNonces;
 						}
 						// if the memory was acquired, but it was not the right block, give it free
 						else if (memory != nullptr)
-							globalBufferSize.free(memory);
-						// this should never happen.. no memory allocated, not cancelled, wrong block
+						{
+							globalBufferSize.free(memory, memoryNode);
+
+							if (memoryMirror != nullptr)
+							{
+								globalBufferSize.free(memoryMirror, mirrorNode);
+								memoryMirror = nullptr;
+							}
+						}
+						// no memory allocated, because the round changed while waiting for it
 						else;
 					}
 				}
 
 				// check, if the incoming plot-read-notification is for the current round
-				currentBlock = plotReadNotification->blockheight == data_.getCurrentBlockheight();
+				currentBlock = roundEpoch.isCurrent(plotReadNotification->epoch);
 
 				if (!isCancelled() && currentBlock)
 				{
@@ -338,6 +647,18 @@ void Burst::PlotReader::runTask()
 						memToString(plotFile.getSize(), 2),
 						Poco::DateTimeFormatter::format(span, "%s.%i"),
 						memToString(static_cast<Poco::UInt64>(bytesPerSeconds), 2));
+
+					const auto block = data_.getBlockData();
+
+					// the finished files are only counted, one event per file would bloat the timeline
+					if (block != nullptr && block->getBlockheight() == plotReadNotification->blockheight)
+					{
+						block->getTimeline().recordLast(RoundTimeline::Stage::FileFinished);
+						block->addReadThroughput({
+							plotReadNotification->dir, plotFile.getPath(), static_cast<Poco::UInt64>(nonceBytes),
+							static_cast<Poco::UInt64>(fileReadTime)
+						});
+					}
 				}
 
 				// if it was cancelled, we push the current plot dir back in the queue again
@@ -350,6 +671,9 @@ void Burst::PlotReader::runTask()
 
 			data_.getBlockData()->setProgress(plotReadNotification->dir, 100.f, plotReadNotification->blockheight);
 
+			if (currentBlock)
+				recordTimeline(plotReadNotification->blockheight, RoundTimeline::Stage::DirFinished, plotReadNotification->dir);
+
 			const auto dirReadDiff = timeStartDir.elapsed();
 			const auto dirReadDiffSeconds = static_cast<float>(dirReadDiff) / 1000 / 1000;
 			const Poco::Timespan span{dirReadDiff};
@@ -359,6 +683,17 @@ void Burst::PlotReader::runTask()
 			for (const auto& plot : plotReadNotification->plotList)
 				totalSizeBytes += plot->getSize();
 
+			if (totalSizeBytes > 0 && currentBlock && !isCancelled())
+			{
+				const auto block = data_.getBlockData();
+
+				if (block != nullptr && block->getBlockheight() == plotReadNotification->blockheight)
+					block->addReadThroughput({
+						plotReadNotification->dir, "", totalSizeBytes / Settings::plotSize * Settings::scoopSize,
+						static_cast<Poco::UInt64>(dirReadTime)
+					});
+			}
+
 			if (plotReadNotification->type == PlotDir::Type::Sequential && totalSizeBytes > 0 && currentBlock)
 			{
 				const auto sumNonces = totalSizeBytes / Settings::plotSize;
@@ -397,52 +732,53 @@ void Burst::PlotReader::runTask()
 
 void Burst::PlotReadProgress::reset(Poco::UInt64 blockheight, uintmax_t max)
 {
-	std::lock_guard<std::mutex> guard(mutex_);
-	progress_ = 0;
-	blockheight_ = blockheight;
-	max_ = max;
+	// the counter is cleared before the new round is published
+	getCounter(blockheight).store(0);
+	max_.store(max);
+	blockheight_.store(blockheight);
 }
 
 void Burst::PlotReadProgress::add(uintmax_t value, Poco::UInt64 blockheight)
 {
-	{
-		std::lock_guard<std::mutex> guard(mutex_);
+	if (blockheight != blockheight_.load(std::memory_order_relaxed))
+		return;
 
-		if (blockheight != blockheight_)
-			return;
-
-		progress_ += value;
-	}
-
-	fireProgressChanged();
+	getCounter(blockheight).fetch_add(value, std::memory_order_relaxed);
 }
 
 bool Burst::PlotReadProgress::isReady() const
 {
-	std::lock_guard<std::mutex> guard(mutex_);
-	return progress_ >= max_;
+	return getValue() >= max_.load();
 }
 
 uintmax_t Burst::PlotReadProgress::getValue() const
 {
-	std::lock_guard<std::mutex> guard(mutex_);
-	return progress_;
+	return getCounter(blockheight_.load()).load(std::memory_order_relaxed);
 }
 
 float Burst::PlotReadProgress::getProgress() const
 {
-	std::lock_guard<std::mutex> guard(mutex_);
+	const auto max = max_.load();
 
-	if (max_ == 0.f)
+	if (max == 0)
 		return 0.f;
 
-	return progress_ * 1.f / max_ * 100;
+	return std::min(getValue(), max) * 1.f / max * 100;
+}
+
+Poco::UInt64 Burst::PlotReadProgress::getBlockheight() const
+{
+	return blockheight_.load();
+}
+
+std::atomic<uintmax_t>& Burst::PlotReadProgress::getCounter(const Poco::UInt64 blockheight)
+{
+	return progress_[blockheight % progress_.size()];
 }
 
-void Burst::PlotReadProgress::fireProgressChanged()
+const std::atomic<uintmax_t>& Burst::PlotReadProgress::getCounter(const Poco::UInt64 blockheight) const
 {
-	auto progress = getProgress();
-	progressChanged.notify(this, progress);
+	return progress_[blockheight % progress_.size()];
 }
 
 Burst::PlotReadProgressGuard::PlotReadProgressGuard(std::shared_ptr<PlotReadProgress> progress, const Poco::UInt64 nonces,
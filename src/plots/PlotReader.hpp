@@ -23,17 +23,20 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
 #include <memory>
 #include <thread>
 #include <mutex>
 #include "Declarations.hpp"
 #include <Poco/Task.h>
 #include <atomic>
+#include <array>
 #include <Poco/Notification.h>
 #include "mining/MinerConfig.hpp"
 #include "Plot.hpp"
 #include <Poco/NotificationQueue.h>
-#include <Poco/MemoryPool.h>
+#include <Poco/Mutex.h>
+#include <Poco/RWLock.h>
 
 namespace Poco
 {
@@ -45,12 +48,30 @@ namespace Burst
 	class MinerData;
 	class PlotReadProgress;
 
+	/**
+	 * \brief The buffers for the read chunks, split into one pool per NUMA node.
+	 */
 	class GlobalBufferSize
 	{
 	public:
+		~GlobalBufferSize();
+
+		/**
+		 * \brief Sets the limit of the buffers and splits it into the configured amount of chunks.
+		 * The limits are changed in place, the buffers in use stay valid and are given back,
+		 * when they are released and do not fit the new limits anymore.
+		 * \param max The maximum size of all buffers in bytes.
+		 */
 		void setMax(Poco::UInt64 max);
-		void* reserve();
-		void free(void* memory);
+
+		/**
+		 * \brief Reserves a buffer, preferably from the pool of a node.
+		 * When the pool of the node is exhausted, the buffer is taken from another node.
+		 * \param node The wanted node, is set to the node the buffer belongs to.
+		 * \return The buffer, nullptr if all pools are exhausted.
+		 */
+		void* reserve(size_t& node);
+		void free(void* memory, size_t node);
 		
 		Poco::UInt64 getSize() const;
 		Poco::UInt64 getMax() const;
@@ -58,9 +79,124 @@ namespace Burst
 		Poco::NotificationQueue chunkQueue;
 
 	private:
+		// the buffers of one node
+		struct Pool
+		{
+			// every allocated buffer and its size
+			std::unordered_map<void*, Poco::UInt64> buffers;
+			// the released buffers, that can be reserved again
+			std::vector<void*> free;
+			size_t maxBuffers = 0;
+		};
+
+		void deallocate(Pool& pool, void* memory);
+
 		Poco::Event reserveEvent_;
-		Poco::UInt64 max_;
-		std::unique_ptr<Poco::MemoryPool> memoryPool_;
+		Poco::UInt64 max_ = 0, chunkSize_ = 0, allocated_ = 0;
+		unsigned chunks_ = 0;
+		std::vector<Pool> pools_;
+		mutable Poco::FastMutex mutex_;
+	};
+
+	/**
+	 * \brief Wakes up one idle worker without work, so it checks, if it is cancelled or retired.
+	 * It stays in the queue until a worker takes it, so a worker that is not waiting yet does not miss it.
+	 */
+	struct WorkerNotification : Poco::Notification
+	{
+		/**
+		 * \brief Queues one wake up per worker in front of the work.
+		 * \param count The amount of workers to wake up.
+		 * \param queue The queue the workers are waiting on.
+		 */
+		static void post(unsigned count, Poco::NotificationQueue& queue);
+	};
+
+	/**
+	 * \brief Lets a pool of workers shrink without stopping the whole pool.
+	 * The workers ask for retirement between two units of work, so no queued
+	 * notification and no reserved buffer gets lost.
+	 */
+	class WorkerRetirement
+	{
+	public:
+		/**
+		 * \brief Asks the given amount of workers to retire.
+		 * \param count The amount of workers that should stop after their current work.
+		 * \param queue The queue the workers are waiting on, one worker is woken up per retirement.
+		 */
+		void request(unsigned count, Poco::NotificationQueue& queue);
+
+		/**
+		 * \brief Called by a worker at a chunk boundary.
+		 * \return true, if the worker has to stop now, false otherwise.
+		 */
+		bool tryRetire();
+
+		/**
+		 * \brief Withdraws the retirements that were not taken yet.
+		 * \return The amount of withdrawn retirements.
+		 */
+		unsigned withdraw();
+
+	private:
+		std::atomic<unsigned> pending_{0};
+	};
+
+	/**
+	 * \brief The verification queues of the NUMA nodes.
+	 * A read chunk is verified by the verifiers of the node its buffer is on.
+	 * A node without verifiers hands its chunks to the next node, that has some.
+	 */
+	class VerificationQueues
+	{
+	public:
+		explicit VerificationQueues(size_t nodes);
+
+		/**
+		 * \brief Queues a read chunk for the verifiers of a node.
+		 * \param notification The chunk.
+		 * \param node The node the buffer of the chunk is on.
+		 */
+		void enqueue(Poco::Notification::Ptr notification, size_t node);
+
+		/**
+		 * \brief Sets the amount of verifiers of every node.
+		 * The chunks, that are queued on a node without verifiers, are moved to the node that verifies them now.
+		 * \param verifiers The amount of verifiers, one entry per node.
+		 */
+		void setVerifiers(const std::vector<unsigned>& verifiers);
+
+		Poco::NotificationQueue& getQueue(size_t node);
+		const std::vector<Poco::NotificationQueue*>& getQueues() const;
+
+	private:
+		size_t getTarget(size_t node) const;
+
+		std::vector<std::unique_ptr<Poco::NotificationQueue>> nodes_;
+		std::vector<Poco::NotificationQueue*> queues_;
+		std::vector<unsigned> verifiers_;
+		mutable Poco::RWLock lock_;
+	};
+
+	/**
+	 * \brief Counts the rounds, so stale work is recognized with one atomic load.
+	 * Every piece of work carries the epoch it was created in and is dropped,
+	 * as soon as a new round started.
+	 */
+	class RoundEpoch
+	{
+	public:
+		/**
+		 * \brief Starts a new round.
+		 * \return The epoch of the new round.
+		 */
+		Poco::UInt64 next();
+		Poco::UInt64 get() const;
+		bool isCurrent(Poco::UInt64 epoch) const;
+
+	private:
+		std::atomic<Poco::UInt64> epoch_{0};
 	};
 
 	struct PlotReadNotification : Poco::Notification
@@ -72,6 +208,8 @@ namespace Burst
 		GensigData gensig;
 		Poco::UInt64 blockheight = 0;
 		Poco::UInt64 baseTarget = 0;
+		Poco::UInt64 epoch = 0;
+		size_t node = 0;
 		std::vector<std::pair<std::string, std::vector<std::shared_ptr<PlotFile>>>> relatedPlotLists;
 		PlotDir::Type type = PlotDir::Type::Sequential;
 		bool wakeUpCall = false;
@@ -82,20 +220,28 @@ namespace Burst
 	public:
 		PlotReader(MinerData& data, std::shared_ptr<PlotReadProgress> progressRead,
 			std::shared_ptr<PlotReadProgress> progressVerify,
-			Poco::NotificationQueue& verificationQueue, Poco::NotificationQueue& plotReadQueue);
+			VerificationQueues& verificationQueues, Poco::NotificationQueue& plotReadQueue,
+			WorkerRetirement& retirement);
 		~PlotReader() override = default;
 
 		void runTask() override;
 
 		static GlobalBufferSize globalBufferSize;
+		static RoundEpoch roundEpoch;
 
 	private:
 		MinerData& data_;
 		std::shared_ptr<PlotReadProgress> progressRead_, progressVerify_;
-		Poco::NotificationQueue* verificationQueue_;
+		VerificationQueues* verificationQueues_;
 		Poco::NotificationQueue* plotReadQueue_;
+		WorkerRetirement* retirement_;
 	};
 
+	/**
+	 * \brief The progress of reading or verifying all plot files in a round.
+	 * The reader and verifier threads only add to atomic counters,
+	 * the progress is sampled and shown by the miner in its own thread.
+	 */
 	class PlotReadProgress
 	{
 	public:
@@ -105,14 +251,20 @@ namespace Burst
 		uintmax_t getValue() const;
 		float getProgress() const;
 
-		Poco::BasicEvent<float> progressChanged;
+		/**
+		 * \brief The height of the round, the progress was reset for last.
+		 */
+		Poco::UInt64 getBlockheight() const;
 
 	private:
-		uintmax_t progress_ = 0, max_ = 0;
-		Poco::UInt64 blockheight_ = 0;
-		mutable std::mutex mutex_;
+		std::atomic<uintmax_t>& getCounter(Poco::UInt64 blockheight);
+		const std::atomic<uintmax_t>& getCounter(Poco::UInt64 blockheight) const;
 
-		void fireProgressChanged();
+		// one counter for the current and one for the last round,
+		// so late additions of the last round never count for the current one
+		std::array<std::atomic<uintmax_t>, 2> progress_{};
+		std::atomic<uintmax_t> max_{0};
+		std::atomic<Poco::UInt64> blockheight_{0};
 	};
 
 	class PlotReadProgressGuard
@@ -34,6 +34,12 @@
 #include "gpu/gpu_shell.hpp"
 #include "gpu/algorithm/gpu_algorithm_atomic.hpp"
 #include "libShabal.h"
+#include "logging/Metrics.hpp"
+#include "logging/Tracing.hpp"
+#include "mining/MinerConfig.hpp"
+#include "mining/Numa.hpp"
+#include <chrono>
+#include <algorithm>
 
 namespace Burst
 {
@@ -52,7 +58,10 @@ namespace Burst
 		GensigData gensig;
 		Poco::UInt64 baseTarget = 0;
 		Poco::UInt64 nonces = 0;
+		Poco::UInt64 epoch = 0;
+		size_t node = 0;
 		std::shared_ptr<PlotReadProgressGuard> progress;
+		Poco::Timestamp enqueued;
 	};
 	
 	using DeadlineTuple = std::pair<Poco::UInt64, Poco::UInt64>;
@@ -62,7 +71,8 @@ namespace Burst
 	class PlotVerifier : public Poco::Task
 	{
 	public:
-		PlotVerifier(MinerData& data, Poco::NotificationQueue& queue, SubmitFunction submitFunction);
+		PlotVerifier(MinerData& data, Poco::NotificationQueue& queue, SubmitFunction submitFunction,
+		             WorkerRetirement& retirement, size_t node);
 		~PlotVerifier() override;
 		void runTask() override;
 		
@@ -70,11 +80,14 @@ namespace Burst
 		MinerData* data_;
 		Poco::NotificationQueue* queue_;
 		SubmitFunction submitFunction_;
+		WorkerRetirement* retirement_;
+		size_t node_;
 	};
 
 	template <typename TVerificationAlgorithm>
-	PlotVerifier<TVerificationAlgorithm>::PlotVerifier(MinerData& data, Poco::NotificationQueue& queue, SubmitFunction submitFunction)
-		: Task("PlotVerifier"), data_{&data}, queue_{&queue}, submitFunction_{submitFunction}
+	PlotVerifier<TVerificationAlgorithm>::PlotVerifier(MinerData& data, Poco::NotificationQueue& queue, SubmitFunction submitFunction,
+	                                                   WorkerRetirement& retirement, const size_t node)
+		: Task("PlotVerifier"), data_{&data}, queue_{&queue}, submitFunction_{submitFunction}, retirement_{&retirement}, node_{node}
 	{
 	}
 
@@ -87,6 +100,9 @@ namespace Burst
 	void PlotVerifier<TVerificationAlgorithm>::runTask()
 	{
 		void* stream = nullptr;
+
+		// the queue only gets the chunks in the buffers of our node, so we hash on it
+		Numa::pinThread(node_);
 		
 		if (!TVerificationAlgorithm::initStream(&stream))
 		{
@@ -95,28 +111,80 @@ namespace Burst
 			return;
 		}
 
+		const auto config = MinerConfig::getConfig().getSnapshot();
+		const auto backend = config->processorType == "CPU" ? config->cpuInstructionSet : config->processorType;
+
+		auto& queueWait = Metrics::histogram("creepminer_verify_queue_wait_seconds",
+		                                     "Time a read chunk waited in the queue for a verifier",
+		                                     {}, Metrics::latencyBounds(), 1e-6);
+		auto& nonceTime = Metrics::histogram("creepminer_verifier_nonce_nanoseconds", "Verification time per nonce",
+		                                     {{"backend", backend}}, MetricHistogram::exponentialBounds(10, 2, 14), 1);
+		auto& verifiedNonces = Metrics::counter("creepminer_verified_nonces_total", "Number of verified nonces",
+		                                        {{"backend", backend}});
+		auto& staleChunks = Metrics::counter("creepminer_stale_chunks_dropped_total",
+		                                     "Chunks of an old round, that were dropped without verifying them", {{"stage", "verifier"}});
+
 		while (!isCancelled())
 		{
 			try
 			{
+				// the pool shrinks, we stop between two chunks
+				if (retirement_->tryRetire())
+					break;
+
+				TraceSpan waitSpan{"wait for chunk", "verifier"};
 				Poco::Notification::Ptr notification(queue_->waitDequeueNotification());
 				VerifyNotification::Ptr verifyNotification;
+				waitSpan.end();
 
 				if (notification)
 					verifyNotification = notification.cast<VerifyNotification>();
-				else
-					break;
+
+				// woken up without work, check again if we are cancelled or retired
+				if (verifyNotification.isNull())
+					continue;
+
+				queueWait.observe(verifyNotification->enqueued.elapsed());
+
+				// the chunk was read for an old round, give the buffer free without verifying it
+				if (!PlotReader::roundEpoch.isCurrent(verifyNotification->epoch))
+				{
+					PlotReader::globalBufferSize.free(verifyNotification->buffer, verifyNotification->node);
+					staleChunks.add(1);
+					continue;
+				}
 
 				const auto stopFunction = [this, &verifyNotification]()
 				{
-					return isCancelled() || verifyNotification->block != data_->getCurrentBlockheight();
+					return isCancelled() || !PlotReader::roundEpoch.isCurrent(verifyNotification->epoch);
 				};
 
+				const auto verifyStart = std::chrono::steady_clock::now();
+				TraceSpan verifySpan{"verify chunk", "verifier"};
+
 				auto bestResult = TVerificationAlgorithm::run(verifyNotification->buffer, verifyNotification->nonces,
 				                                              verifyNotification->nonceRead, verifyNotification->nonceStart,
 				                                              verifyNotification->baseTarget, verifyNotification->gensig,
 				                                              stopFunction, stream);
 
+				verifySpan.end();
+
+				if (verifyNotification->nonces > 0)
+				{
+					const auto verifyTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+						std::chrono::steady_clock::now() - verifyStart).count();
+					nonceTime.observe(static_cast<Poco::UInt64>(verifyTime) / verifyNotification->nonces);
+					verifiedNonces.add(verifyNotification->nonces);
+				}
+
+				const auto block = data_->getBlockData();
+
+				if (block != nullptr && block->getBlockheight() == verifyNotification->block)
+				{
+					block->getTimeline().recordOnce(RoundTimeline::Stage::FirstChunkVerified);
+					block->getTimeline().recordLast(RoundTimeline::Stage::LastVerification);
+				}
+
 				if (bestResult.first != 0 && bestResult.second != 0)
 				{
 					submitFunction_(bestResult.first,
@@ -127,7 +195,7 @@ namespace Burst
 					                true);
 				}
 
-				PlotReader::globalBufferSize.free(verifyNotification->buffer);
+				PlotReader::globalBufferSize.free(verifyNotification->buffer, verifyNotification->node);
 			}
 			catch (Poco::Exception& exc)
 			{
@@ -231,14 +299,35 @@ namespace Burst
 		                         const Poco::UInt64 nonceStart, const Poco::UInt64 baseTarget, const GensigData& gensig,
 		                         const std::function<bool()>& stop, void* stream)
 		{
-            uint64_t deadline = std::numeric_limits<uint64_t>::max();
-            uint64_t offset = 0;
-            std::vector<uint8_t> scoops;
-            for (size_t i = 0; i < buffer->size(); i++) { // Compile scoops into one big array
-                scoops.insert(scoops.end(), &buffer[i][0], &buffer[i][Settings::scoopSize]);
-            }
-            shabal_findBestDeadlineDirect(reinterpret_cast<const char*>(scoops.data()), buffer->size(), reinterpret_cast<const char*>(gensig.data()), &deadline, &offset);
-            return {nonceStart + nonceRead + offset, deadline};
+			// the scoops are already one contiguous array, so they are hashed in place;
+			// a chunk is split into parts, to stop early when the round changes
+			constexpr size_t partSize = 4096;
+			auto bestDeadline = std::numeric_limits<uint64_t>::max();
+			uint64_t bestOffset = 0;
+
+			for (size_t begin = 0; begin < size; begin += partSize)
+			{
+				if (stop())
+					return {0, 0};
+
+				const auto nonces = std::min(partSize, size - begin);
+				auto deadline = std::numeric_limits<uint64_t>::max();
+				uint64_t offset = 0;
+
+				shabal_findBestDeadlineDirect(reinterpret_cast<const char*>(buffer + begin), nonces,
+				                              reinterpret_cast<const char*>(gensig.data()), &deadline, &offset);
+
+				if (deadline < bestDeadline)
+				{
+					bestDeadline = deadline;
+					bestOffset = begin + offset;
+				}
+			}
+
+			if (bestDeadline == std::numeric_limits<uint64_t>::max())
+				return {0, 0};
+
+			return {nonceStart + nonceRead + bestOffset, bestDeadline};
 		}
 	};
 
@@ -38,9 +38,9 @@ Burst::Account::Account(AccountId id)
 	  wallet_{nullptr}
 {}
 
-Burst::Account::Account(const Wallet& wallet, AccountId id, bool fetchAll)
+Burst::Account::Account(std::shared_ptr<const Wallet> wallet, AccountId id, bool fetchAll)
 	: id_{id},
-	  wallet_{&wallet}
+	  wallet_{std::move(wallet)}
 {
 	if (fetchAll)
 	{
@@ -50,10 +50,16 @@ Burst::Account::Account(const Wallet& wallet, AccountId id, bool fetchAll)
 	}
 }
 
-void Burst::Account::setWallet(const Wallet& wallet)
+void Burst::Account::setWallet(std::shared_ptr<const Wallet> wallet)
 {
 	Poco::Mutex::ScopedLock lock{ mutex_ };
-	wallet_ = &wallet;
+	wallet_ = std::move(wallet);
+}
+
+std::shared_ptr<const Burst::Wallet> Burst::Account::getWallet() const
+{
+	Poco::Mutex::ScopedLock lock{ mutex_ };
+	return wallet_;
 }
 
 Burst::AccountId Burst::Account::getId() const
@@ -143,6 +149,14 @@ Poco::ActiveResult<std::vector<Burst::Block>> Burst::Account::getOrLoadAccountBl
 	return DataLoader::getInstance().getAccountBlocks(std::make_tuple(std::ref(*this), reset));
 }
 
+void Burst::Account::setData(const std::string& name, const AccountId rewardRecipient, const std::vector<Block>& blocks)
+{
+	Poco::Mutex::ScopedLock lock{ mutex_ };
+	name_ = name;
+	rewardRecipient_ = rewardRecipient;
+	blocks_ = blocks;
+}
+
 std::string Burst::Account::getAddress() const
 {
 	return NxtAddress(getId()).to_string();
@@ -193,9 +207,11 @@ std::string Burst::Account::DataLoader::runGetName(const AsyncParameter& paramet
 	auto& account = std::get<0>(parameter);
 	const auto reset = std::get<1>(parameter);
 
-	return getHelper<std::string>(account.name_, account.wallet_, reset, account.mutex_, [&account](std::string& name)
+	const auto wallet = account.getWallet();
+
+	return getHelper<std::string>(account.name_, wallet.get(), reset, account.mutex_, [&account, &wallet](std::string& name)
 	{
-		return account.wallet_->getNameOfAccount(account.id_, name);
+		return wallet->getNameOfAccount(account.id_, name);
 	});
 }
 
@@ -204,9 +220,11 @@ Burst::AccountId Burst::Account::DataLoader::runGetRewardRecipient(const AsyncPa
 	auto& account = std::get<0>(parameter);
 	const auto reset = std::get<1>(parameter);
 	
-	return getHelper<AccountId>(account.rewardRecipient_, account.wallet_, reset, account.mutex_, [&account](AccountId& rewardRecipient)
+	const auto wallet = account.getWallet();
+
+	return getHelper<AccountId>(account.rewardRecipient_, wallet.get(), reset, account.mutex_, [&account, &wallet](AccountId& rewardRecipient)
 	{
-		return account.wallet_->getRewardRecipientOfAccount(account.id_, rewardRecipient);
+		return wallet->getRewardRecipientOfAccount(account.id_, rewardRecipient);
 	});
 }
 
@@ -215,13 +233,15 @@ std::vector<Burst::Block> Burst::Account::DataLoader::runGetAccountBlocks(const
 	auto& account = std::get<0>(parameter);
 	const auto reset = std::get<1>(parameter);
 	
-	return getHelper<std::vector<Block>>(account.blocks_, account.wallet_, reset, account.mutex_, [&account](std::vector<Block>& blocks)
+	const auto wallet = account.getWallet();
+
+	return getHelper<std::vector<Block>>(account.blocks_, wallet.get(), reset, account.mutex_, [&account, &wallet](std::vector<Block>& blocks)
 	{
-		return account.wallet_->getAccountBlocks(account.id_, blocks);
+		return wallet->getAccountBlocks(account.id_, blocks);
 	});
 }
 
-std::shared_ptr<Burst::Account> Burst::Accounts::getAccount(AccountId id, const Wallet& wallet, bool persistent)
+std::shared_ptr<Burst::Account> Burst::Accounts::getAccount(AccountId id, std::shared_ptr<const Wallet> wallet, bool persistent)
 {
 	Poco::FastMutex::ScopedLock lock{ mutex_ };
 
@@ -230,7 +250,7 @@ std::shared_ptr<Burst::Account> Burst::Accounts::getAccount(AccountId id, const
 	// if the account is not in the cache, we have to fetch him
 	if (iter == accounts_.end())
 	{
-		auto account = std::make_shared<Account>(wallet, id, persistent);
+		auto account = std::make_shared<Account>(std::move(wallet), id, persistent);
 
 		// save the account in the cache if wanted
 		if (persistent)
@@ -246,6 +266,23 @@ std::shared_ptr<Burst::Account> Burst::Accounts::getAccount(AccountId id, const
 	return accounts_[id];
 }
 
+std::shared_ptr<Burst::Account> Burst::Accounts::addAccount(AccountId id, std::shared_ptr<const Wallet> wallet)
+{
+	Poco::FastMutex::ScopedLock lock{ mutex_ };
+
+	auto& account = accounts_[id];
+
+	if (account == nullptr)
+	{
+		account = std::make_shared<Account>(std::move(wallet), id, false);
+		log_debug(MinerLogger::general, "Cached accounts: %z", accounts_.size());
+	}
+	else
+		account->setWallet(std::move(wallet));
+
+	return account;
+}
+
 bool Burst::Accounts::isLoaded(AccountId id) const
 {
 	Poco::FastMutex::ScopedLock lock{ mutex_ };
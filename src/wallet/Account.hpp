@@ -24,6 +24,7 @@
 #include "mining/Deadline.hpp"
 #include <Poco/Nullable.h>
 #include <unordered_map>
+#include <memory>
 #include <Poco/Activity.h>
 #include <Poco/ActiveMethod.h>
 #include <Poco/JSON/Object.h>
@@ -41,9 +42,14 @@ namespace Burst
 	public:
 		Account();
 		Account(AccountId id);
-		Account(const Wallet& wallet, AccountId id, bool fetchAll = false);
+		Account(std::shared_ptr<const Wallet> wallet, AccountId id, bool fetchAll = false);
 
-		void setWallet(const Wallet& wallet);
+		/**
+		 * \brief Sets the wallet, that is asked for the data of the account.
+		 * A fetch, that is already running, keeps the old wallet until it is done.
+		 * \param wallet The wallet.
+		 */
+		void setWallet(std::shared_ptr<const Wallet> wallet);
 
 		AccountId getId() const;
 		const std::string& getName() const;
@@ -55,6 +61,14 @@ namespace Burst
 		Poco::ActiveResult<AccountId> getOrLoadRewardRecipient(bool reset = false);
 		Poco::ActiveResult<std::vector<Block>> getOrLoadAccountBlocks(bool reset = false);
 
+		/**
+		 * \brief Sets the data of the account, that was fetched or cached somewhere else.
+		 * \param name The name of the account.
+		 * \param rewardRecipient The reward recipient of the account.
+		 * \param blocks The blocks, the account has won.
+		 */
+		void setData(const std::string& name, AccountId rewardRecipient, const std::vector<Block>& blocks);
+
 		Poco::JSON::Object::Ptr toJSON() const;
 		
 	private:
@@ -79,18 +93,29 @@ namespace Burst
 		};
 
 	private:
+		std::shared_ptr<const Wallet> getWallet() const;
+
 		AccountId id_;
 		Poco::Nullable<std::string> name_;
 		Poco::Nullable<AccountId> rewardRecipient_;
 		Poco::Nullable<std::vector<Block>> blocks_;
-		const Wallet* wallet_;
+		std::shared_ptr<const Wallet> wallet_;
 		mutable Poco::Mutex mutex_;
 	};
 
 	class Accounts
 	{
 	public:
-		std::shared_ptr<Account> getAccount(AccountId id, const Wallet& wallet, bool persistent);
+		std::shared_ptr<Account> getAccount(AccountId id, std::shared_ptr<const Wallet> wallet, bool persistent);
+
+		/**
+		 * \brief Returns a persistent account or adds it, without fetching its data from the wallet.
+		 * An existing account uses the given wallet from now on.
+		 * \param id The id of the account.
+		 * \param wallet The wallet, the account is using.
+		 * \return The account.
+		 */
+		std::shared_ptr<Account> addAccount(AccountId id, std::shared_ptr<const Wallet> wallet);
 		bool isLoaded(AccountId id) const;
 		std::vector<std::shared_ptr<Account>> getAccounts() const;
 
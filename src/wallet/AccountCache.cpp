@@ -0,0 +1,355 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "AccountCache.hpp"
+#include "Account.hpp"
+#include "Wallet.hpp"
+#include "mining/MinerConfig.hpp"
+#include "logging/MinerLogger.hpp"
+#include <Poco/Data/Statement.h>
+#include <Poco/NumberFormatter.h>
+#include <Poco/NumberParser.h>
+#include <Poco/StringTokenizer.h>
+#include <Poco/Timestamp.h>
+#include <numeric>
+
+using namespace Poco::Data::Keywords;
+
+Burst::AccountCache::AccountCache(const std::string& databasePath, Accounts& accounts,
+                                  std::function<void(Poco::UInt64)> onWonBlocks)
+	: wallet_{std::make_shared<const Wallet>()},
+	  accounts_{accounts},
+	  onWonBlocks_{std::move(onWonBlocks)},
+	  running_{true},
+	  invalidated_{false},
+	  blocksDue_{false}
+{
+	poco_ndc(AccountCache::AccountCache);
+
+	try
+	{
+		session_ = std::make_unique<Poco::Data::Session>("SQLite", databasePath);
+
+		// the database writer uses the same file, so we wait for its transactions
+		int busyTimeout = 0;
+		*session_ << "PRAGMA busy_timeout=5000", into(busyTimeout), now;
+
+		// the table is created by the migrations of the miner data
+		load();
+	}
+	catch (const Poco::Exception& e)
+	{
+		log_error(MinerLogger::wallet, "Could not open the account cache, the accounts are only cached in memory: %s",
+			e.displayText());
+		log_current_stackframe(MinerLogger::wallet);
+		session_.reset();
+	}
+
+	thread_.setName("AccountCache");
+	thread_.start(*this);
+}
+
+Burst::AccountCache::~AccountCache()
+{
+	running_ = false;
+	wakeUp_.set();
+	thread_.join();
+}
+
+void Burst::AccountCache::track(const AccountId id)
+{
+	Poco::FastMutex::ScopedLock lock{mutex_};
+
+	if (!tracked_.insert(id).second)
+		return;
+
+	const auto entry = entries_.find(id);
+
+	if (entry != entries_.end())
+		apply(id, entry->second);
+	else
+	{
+		accounts_.addAccount(id, getWallet());
+		wakeUp_.set();
+	}
+}
+
+void Burst::AccountCache::invalidate()
+{
+	invalidated_ = true;
+	wakeUp_.set();
+}
+
+void Burst::AccountCache::setWallet(const Url& url)
+{
+	std::atomic_store(&wallet_, std::make_shared<const Wallet>(url));
+	invalidate();
+}
+
+std::shared_ptr<const Burst::Wallet> Burst::AccountCache::getWallet() const
+{
+	return std::atomic_load(&wallet_);
+}
+
+void Burst::AccountCache::scanBlocks()
+{
+	blocksDue_ = true;
+	wakeUp_.set();
+}
+
+Poco::UInt64 Burst::AccountCache::getWonBlocks() const
+{
+	Poco::FastMutex::ScopedLock lock{mutex_};
+
+	return std::accumulate(tracked_.begin(), tracked_.end(), Poco::UInt64{0}, [this](const Poco::UInt64 sum, const AccountId id)
+	{
+		const auto entry = entries_.find(id);
+		return entry == entries_.end() ? sum : sum + entry->second.blocks.size();
+	});
+}
+
+void Burst::AccountCache::run()
+{
+	// the age of the entries is checked every minute, new accounts wake the cache up earlier
+	const long checkInterval = 60 * 1000;
+
+	while (running_)
+	{
+		refresh();
+		wakeUp_.tryWait(checkInterval);
+	}
+}
+
+void Burst::AccountCache::load()
+{
+	std::vector<AccountId> ids, rewardRecipients;
+	std::vector<std::string> names, blocks;
+	std::vector<Poco::UInt64> updated, heights;
+
+	*session_ << "SELECT id, name, rewardRecipient, blocks, updated, height FROM account",
+		into(ids), into(names), into(rewardRecipients), into(blocks), into(updated), into(heights), now;
+
+	Poco::FastMutex::ScopedLock lock{mutex_};
+
+	for (size_t i = 0; i < ids.size(); ++i)
+	{
+		auto& entry = entries_[ids[i]];
+		entry.name = names[i];
+		entry.rewardRecipient = rewardRecipients[i];
+		entry.blocks = blocksFromString(blocks[i]);
+		entry.updated = updated[i];
+		entry.height = heights[i];
+	}
+
+	log_debug(MinerLogger::wallet, "Loaded %z cached accounts", entries_.size());
+}
+
+void Burst::AccountCache::refresh()
+{
+	poco_ndc(AccountCache::refresh);
+
+	const auto ttl = static_cast<Poco::UInt64>(MinerConfig::getConfig().getAccountCacheTtl());
+	const auto now = static_cast<Poco::UInt64>(Poco::Timestamp().epochTime());
+	const auto invalidated = invalidated_.load();
+	const auto blocksDue = blocksDue_.load();
+
+	// the due accounts and if their name and reward recipient are outdated
+	std::vector<std::pair<AccountId, bool>> due;
+
+	// every account is due for new blocks, but only the ones never fetched or too old for the rest
+	{
+		Poco::FastMutex::ScopedLock lock{mutex_};
+
+		for (const auto id : tracked_)
+		{
+			const auto entry = entries_.find(id);
+			const auto outdated = invalidated || entry == entries_.end() || now - entry->second.updated >= ttl;
+
+			if (outdated || blocksDue)
+				due.emplace_back(id, outdated);
+		}
+	}
+
+	// a new wallet is only used by the next refresh
+	const auto wallet = getWallet();
+
+	// without a wallet the flags stay set, so the accounts are fetched as soon as there is one
+	if (due.empty() || !wallet->isActive())
+		return;
+
+	const Poco::Timestamp refreshStart;
+	auto failed = false;
+	std::vector<std::pair<AccountId, Entry>> fetched;
+	fetched.reserve(due.size());
+
+	for (const auto& account : due)
+	{
+		if (!running_)
+			return;
+
+		const auto id = account.first;
+		const auto outdated = account.second;
+		Entry entry;
+
+		{
+			Poco::FastMutex::ScopedLock lock{mutex_};
+			const auto cached = entries_.find(id);
+
+			if (cached != entries_.end())
+				entry = cached->second;
+		}
+
+		// an account without a name or reward recipient is valid, but without the blocks we keep the old data
+		if (outdated)
+		{
+			entry.updated = now;
+			wallet->getNameOfAccount(id, entry.name);
+			wallet->getRewardRecipientOfAccount(id, entry.rewardRecipient);
+		}
+
+		// only the blocks above the cursor are fetched, without a cursor all blocks are fetched
+		const auto fullScan = entry.height == 0;
+		std::vector<Block> newBlocks;
+
+		if (!wallet->getAccountBlocksAbove(id, entry.height, newBlocks, entry.height))
+		{
+			failed = true;
+			continue;
+		}
+
+		// nothing changed, so there is nothing to store
+		if (!outdated && newBlocks.empty() && (!fullScan || entry.blocks.empty()))
+			continue;
+
+		if (fullScan)
+			entry.blocks = std::move(newBlocks);
+		else
+			entry.blocks.insert(entry.blocks.begin(), newBlocks.begin(), newBlocks.end());
+		fetched.emplace_back(id, std::move(entry));
+	}
+
+	{
+		Poco::FastMutex::ScopedLock lock{mutex_};
+
+		for (const auto& entry : fetched)
+		{
+			entries_[entry.first] = entry.second;
+			apply(entry.first, entry.second);
+		}
+	}
+
+	store(fetched);
+
+	// the flags are only cleared, when every account was fetched from the wallet, that is still the current one,
+	// otherwise the next check retries them
+	if (!failed && wallet == getWallet())
+	{
+		if (invalidated)
+			invalidated_.exchange(false);
+
+		if (blocksDue)
+			blocksDue_.exchange(false);
+	}
+
+	if (onWonBlocks_)
+		onWonBlocks_(getWonBlocks());
+
+	log_debug(MinerLogger::wallet, "Refreshed %z of %z cached accounts in %ss", fetched.size(), due.size(),
+		Poco::NumberFormatter::format(static_cast<double>(refreshStart.elapsed()) / 1000000, 3));
+}
+
+void Burst::AccountCache::store(const std::vector<std::pair<AccountId, Entry>>& entries)
+{
+	poco_ndc(AccountCache::store);
+
+	if (session_ == nullptr || entries.empty())
+		return;
+
+	try
+	{
+		AccountId id = 0, rewardRecipient = 0;
+		std::string name, blocks;
+		Poco::UInt64 updated = 0, height = 0;
+
+		Poco::Data::Statement insert{*session_};
+		insert << "INSERT OR REPLACE INTO account (id, name, rewardRecipient, blocks, updated, height) VALUES (?, ?, ?, ?, ?, ?)",
+			use(id), use(name), use(rewardRecipient), use(blocks), use(updated), use(height);
+
+		session_->begin();
+
+		for (const auto& entry : entries)
+		{
+			id = entry.first;
+			name = entry.second.name;
+			rewardRecipient = entry.second.rewardRecipient;
+			blocks = blocksToString(entry.second.blocks);
+			updated = entry.second.updated;
+			height = entry.second.height;
+			insert.execute();
+		}
+
+		session_->commit();
+	}
+	catch (const Poco::Exception& e)
+	{
+		if (session_->isTransaction())
+			session_->rollback();
+
+		log_error(MinerLogger::wallet, "Could not write the account cache: %s", e.displayText());
+		log_current_stackframe(MinerLogger::wallet);
+	}
+}
+
+void Burst::AccountCache::apply(const AccountId id, const Entry& entry) const
+{
+	accounts_.addAccount(id, getWallet())->setData(entry.name, entry.rewardRecipient, entry.blocks);
+}
+
+std::string Burst::AccountCache::blocksToString(const std::vector<Block>& blocks)
+{
+	std::string string;
+
+	for (const auto block : blocks)
+	{
+		if (!string.empty())
+			string += ',';
+
+		string += std::to_string(block);
+	}
+
+	return string;
+}
+
+std::vector<Burst::Block> Burst::AccountCache::blocksFromString(const std::string& blocks)
+{
+	std::vector<Block> result;
+	const Poco::StringTokenizer tokenizer{blocks, ",", Poco::StringTokenizer::TOK_IGNORE_EMPTY | Poco::StringTokenizer::TOK_TRIM};
+
+	for (const auto& token : tokenizer)
+	{
+		Poco::UInt64 block;
+
+		if (Poco::NumberParser::tryParseUnsigned64(token, block))
+			result.emplace_back(block);
+	}
+
+	return result;
+}
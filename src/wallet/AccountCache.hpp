@@ -0,0 +1,136 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include "Declarations.hpp"
+#include "Wallet.hpp"
+#include <Poco/Runnable.h>
+#include <Poco/Thread.h>
+#include <Poco/Event.h>
+#include <Poco/Mutex.h>
+#include <Poco/Data/Session.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Burst
+{
+	class Accounts;
+
+	using Block = Poco::UInt64;
+
+	/**
+	 * \brief Keeps the names, reward recipients and won blocks of the own accounts in the database.
+	 * The cached data is handed to the accounts right away, so the wallet is only asked by the cache
+	 * in its own thread, when the data of an account is older than the configured TTL.
+	 * All due accounts are fetched in one batch and written in one transaction.
+	 * The won blocks are fetched incrementally above the height of the newest known won block.
+	 */
+	class AccountCache : public Poco::Runnable
+	{
+	public:
+		/**
+		 * \brief Opens the cache and loads the cached accounts.
+		 * \param databasePath The path to the database.
+		 * \param accounts The accounts, that get the cached data.
+		 * \param onWonBlocks Called from the cache thread with the number of won blocks after every refresh.
+		 */
+		AccountCache(const std::string& databasePath, Accounts& accounts,
+		             std::function<void(Poco::UInt64)> onWonBlocks);
+		~AccountCache() override;
+
+		/**
+		 * \brief Adds an own account to the cache.
+		 * A cached account gets its data immediately, an unknown one is fetched in the background.
+		 * \param id The id of the account.
+		 */
+		void track(AccountId id);
+
+		/**
+		 * \brief Fetches the data of all tracked accounts again, regardless of their age.
+		 */
+		void invalidate();
+
+		/**
+		 * \brief Sets the wallet, that is asked for the data of the accounts, and fetches all tracked accounts again.
+		 * The wallet is swapped atomically, every reader keeps the wallet it has taken until it is done.
+		 * \param url The URL of the wallet.
+		 */
+		void setWallet(const Url& url);
+
+		/**
+		 * \brief Returns the current wallet.
+		 * \return The wallet, never nullptr.
+		 */
+		std::shared_ptr<const Wallet> getWallet() const;
+
+		/**
+		 * \brief Fetches the new won blocks of all tracked accounts in the background.
+		 */
+		void scanBlocks();
+
+		/**
+		 * \brief Returns the number of blocks, all tracked accounts have won.
+		 * Only the cache is read, the wallet is not asked.
+		 * \return The number of won blocks.
+		 */
+		Poco::UInt64 getWonBlocks() const;
+
+		void run() override;
+
+	private:
+		struct Entry
+		{
+			std::string name;
+			AccountId rewardRecipient = 0;
+			std::vector<Block> blocks;
+			// the unix time of the last fetch
+			Poco::UInt64 updated = 0;
+			// the height of the newest won block (the cursor)
+			Poco::UInt64 height = 0;
+		};
+
+		void load();
+		void refresh();
+		void store(const std::vector<std::pair<AccountId, Entry>>& entries);
+		void apply(AccountId id, const Entry& entry) const;
+
+		static std::string blocksToString(const std::vector<Block>& blocks);
+		static std::vector<Block> blocksFromString(const std::string& blocks);
+
+		std::unique_ptr<Poco::Data::Session> session_;
+		// only accessed with the atomic functions of the shared pointer
+		std::shared_ptr<const Wallet> wallet_;
+		Accounts& accounts_;
+		std::function<void(Poco::UInt64)> onWonBlocks_;
+		std::unordered_map<AccountId, Entry> entries_;
+		std::unordered_set<AccountId> tracked_;
+		mutable Poco::FastMutex mutex_;
+		Poco::Event wakeUp_;
+		std::atomic<bool> running_, invalidated_, blocksDue_;
+		Poco::Thread thread_;
+	};
+}
@@ -31,6 +31,7 @@
 #include "logging/MinerLogger.hpp"
 #include "Account.hpp"
 #include <thread>
+#include <algorithm>
 
 using namespace Poco::Net;
 
@@ -212,6 +213,65 @@ bool Burst::Wallet::getAccountBlocks(AccountId id, std::vector<Block>& blocks) c
 	return false;
 }
 
+bool Burst::Wallet::getAccountBlocksAbove(AccountId id, Poco::UInt64 height, std::vector<Block>& blocks,
+                                          Poco::UInt64& highest) const
+{
+	poco_ndc(Wallet::getAccountBlocksAbove);
+	blocks.clear();
+	highest = height;
+
+	if (!isActive())
+		return false;
+
+	// the wallet sends the newest blocks first, so usually the first page already reaches the height
+	const Poco::UInt64 pageSize = 10;
+
+	try
+	{
+		for (Poco::UInt64 firstIndex = 0;; firstIndex += pageSize)
+		{
+			Poco::JSON::Object::Ptr json;
+
+			Poco::URI uri;
+			uri.setPath("/burst");
+			uri.addQueryParameter("requestType", "getAccountBlocks");
+			uri.addQueryParameter("account", std::to_string(id));
+			uri.addQueryParameter("firstIndex", std::to_string(firstIndex));
+			uri.addQueryParameter("lastIndex", std::to_string(firstIndex + pageSize - 1));
+
+			if (!sendWalletRequest(uri, json) || !json->has("blocks"))
+			{
+				log_debug(MinerLogger::wallet, "Could not get account blocks!");
+				return false;
+			}
+
+			const auto page = json->getArray("blocks");
+
+			for (const auto& blockJson : *page)
+			{
+				const auto block = blockJson.extract<Poco::JSON::Object::Ptr>();
+				const auto blockHeight = block->get("height").convert<Poco::UInt64>();
+
+				if (blockHeight <= height)
+					return true;
+
+				blocks.emplace_back(block->get("block").convert<Poco::UInt64>());
+				highest = std::max(highest, blockHeight);
+			}
+
+			if (page->size() < pageSize)
+				return true;
+		}
+	}
+	catch (const Poco::Exception& e)
+	{
+		log_debug(MinerLogger::wallet, "Could not read the account blocks: %s", e.displayText());
+		blocks.clear();
+		highest = height;
+		return false;
+	}
+}
+
 bool Burst::Wallet::isActive() const
 {
 	return !url_.empty();
@@ -59,6 +59,17 @@ namespace Burst
 		void getAccount(AccountId id, Account& account) const;
 		bool getAccountBlocks(AccountId id, std::vector<Block>& blocks) const;
 
+		/**
+		 * \brief Fetches the blocks an account has won above a height, the newest first.
+		 * The blocks are requested page by page, until a page reaches the height.
+		 * \param id The id of the account.
+		 * \param height Only blocks above this height are fetched (the cursor).
+		 * \param blocks The ids of the won blocks above the height.
+		 * \param highest The height of the newest won block, or the given height if there is none.
+		 * \return true, if all pages were fetched, false otherwise.
+		 */
+		bool getAccountBlocksAbove(AccountId id, Poco::UInt64 height, std::vector<Block>& blocks, Poco::UInt64& highest) const;
+
 		bool isActive() const;
 
 		Wallet& operator=(const Wallet& rhs) = delete;
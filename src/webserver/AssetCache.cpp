@@ -0,0 +1,289 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "AssetCache.hpp"
+#include "RequestHandler.hpp"
+#include "logging/MinerLogger.hpp"
+#include "MinerUtil.hpp"
+#include "mining/MinerConfig.hpp"
+#include <Poco/Net/HTTPServerRequest.h>
+#include <Poco/Net/HTTPServerResponse.h>
+#include <Poco/DeflatingStream.h>
+#include <Poco/SHA1Engine.h>
+#include <Poco/FileStream.h>
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/RecursiveDirectoryIterator.h>
+#include <Poco/String.h>
+#include <sstream>
+
+namespace Burst
+{
+	namespace AssetCacheHelper
+	{
+		std::string getMimeType(const std::string& extension)
+		{
+			const auto ext = Poco::toLower(extension);
+
+			if (ext == "css")
+				return "text/css";
+			if (ext == "js")
+				return "text/javascript";
+			if (ext == "html")
+				return "text/html; charset=utf-8";
+			if (ext == "json")
+				return "application/json";
+			if (ext == "png")
+				return "image/png";
+			if (ext == "ico")
+				return "image/x-icon";
+			if (ext == "svg")
+				return "image/svg+xml";
+			if (ext == "mp3")
+				return "audio/mpeg";
+
+			return "text/plain";
+		}
+
+		bool isCompressible(const std::string& mimeType)
+		{
+			return mimeType.compare(0, 5, "text/") == 0 || mimeType == "application/json" || mimeType == "image/svg+xml";
+		}
+
+		std::string createEtag(const std::string& body)
+		{
+			Poco::SHA1Engine sha;
+			sha.update(body);
+			return Poco::SHA1Engine::digestToHex(sha.digest());
+		}
+
+		std::string normalize(const std::string& path)
+		{
+			const auto begin = path.find_first_not_of('/');
+			return begin == std::string::npos ? "" : path.substr(begin);
+		}
+	}
+}
+
+void Burst::Asset::send(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response) const
+{
+	const auto gzip = !gzipBody.empty() && request.get("Accept-Encoding", "").find("gzip") != std::string::npos;
+	const auto& tag = gzip ? gzipEtag : etag;
+
+	response.set("ETag", tag);
+	response.set("Cache-Control", cacheControl);
+
+	if (!gzipBody.empty())
+		response.set("Vary", "Accept-Encoding");
+
+	// the client already has this version
+	if (request.get("If-None-Match", "") == tag)
+	{
+		response.setStatus(Poco::Net::HTTPResponse::HTTP_NOT_MODIFIED);
+		response.setContentLength(0);
+		response.send();
+		return;
+	}
+
+	const auto& content = gzip ? gzipBody : body;
+
+	response.setStatus(Poco::Net::HTTPResponse::HTTP_OK);
+	response.setContentType(mimeType);
+	response.setContentLength(content.size());
+
+	if (gzip)
+		response.set("Content-Encoding", "gzip");
+
+	response.send().write(content.data(), content.size());
+}
+
+Burst::AssetCache::AssetCache(std::string root)
+	: root_{std::move(root)}
+{}
+
+void Burst::AssetCache::load()
+{
+	poco_ndc(AssetCache::load);
+
+	try
+	{
+		Poco::UInt64 files = 0, bytes = 0, compressedBytes = 0;
+		const Poco::Path root{Poco::Path{root_}.makeAbsolute()};
+
+		for (Poco::RecursiveDirectoryIterator iter{root}, end; iter != end; ++iter)
+		{
+			if (!iter->isFile())
+				continue;
+
+			auto relative = iter.path().toString().substr(root.toString().size());
+			Poco::replaceInPlace(relative, "\\", "/");
+
+			const auto asset = loadFile(AssetCacheHelper::normalize(relative));
+
+			if (asset != nullptr)
+			{
+				++files;
+				bytes += asset->body.size();
+				compressedBytes += asset->gzipBody.empty() ? asset->body.size() : asset->gzipBody.size();
+			}
+		}
+
+		log_debug(MinerLogger::server, "Cached %Lu web files (%s, %s compressed)", files, memToString(bytes, 2),
+			memToString(compressedBytes, 2));
+	}
+	catch (const Poco::Exception& e)
+	{
+		log_error(MinerLogger::server, "Could not cache the web files in '%s': %s", root_, e.displayText());
+		log_current_stackframe(MinerLogger::server);
+	}
+}
+
+std::shared_ptr<const Burst::Asset> Burst::AssetCache::get(const std::string& path)
+{
+	const auto key = AssetCacheHelper::normalize(path);
+
+	// never leave the root directory
+	if (key.empty() || key.find("..") != std::string::npos)
+		return nullptr;
+
+	{
+		std::lock_guard<std::mutex> lock{mutex_};
+		const auto iter = assets_.find(key);
+
+		if (iter != assets_.end())
+			return iter->second;
+	}
+
+	return loadFile(key);
+}
+
+std::shared_ptr<const Burst::Asset> Burst::AssetCache::getTemplate(const std::string& templatePage,
+	const std::string& contentPage, const TemplateVariables& variables)
+{
+	poco_ndc(AssetCache::getTemplate);
+
+	const auto key = templatePage + '|' + contentPage;
+	const auto version = templateVersion_.load();
+	// the pages show the plot dirs, so every rescan, that finds other plot files, renders them again
+	const auto plotsHash = MinerConfig::getConfig().getPlotsHash();
+
+	{
+		std::lock_guard<std::mutex> lock{mutex_};
+		const auto iter = templates_.find(key);
+
+		if (iter != templates_.end() && iter->second.version == version && iter->second.plotsHash == plotsHash)
+			return iter->second.asset;
+	}
+
+	const auto templateAsset = get(templatePage);
+	const auto contentAsset = get(contentPage);
+
+	if (templateAsset == nullptr || contentAsset == nullptr)
+	{
+		log_error(MinerLogger::server, "Could not open 'public/%s' or 'public/%s'!", templatePage, contentPage);
+		return nullptr;
+	}
+
+	try
+	{
+		auto output = templateAsset->body;
+
+		TemplateVariables contentFramework;
+		contentFramework.variables.emplace("content", [&contentAsset]() { return contentAsset->body; });
+
+		contentFramework.inject(output);
+		variables.inject(output);
+
+		// the pages are behind the login, so no shared cache may store them
+		auto rendered = create(std::move(output), "text/html; charset=utf-8", "private, no-cache", true);
+
+		// if the templates got invalidated while rendering, the stored version is already outdated
+		std::lock_guard<std::mutex> lock{mutex_};
+		templates_[key] = {version, plotsHash, rendered};
+		return rendered;
+	}
+	catch (const Poco::Exception& e)
+	{
+		log_error(MinerLogger::server, "Could not render the template '%s': %s", contentPage, e.displayText());
+		log_current_stackframe(MinerLogger::server);
+		return nullptr;
+	}
+}
+
+void Burst::AssetCache::invalidateTemplates()
+{
+	++templateVersion_;
+}
+
+std::shared_ptr<const Burst::Asset> Burst::AssetCache::loadFile(const std::string& path)
+{
+	try
+	{
+		const Poco::Path pathObject{root_ + "/" + path};
+
+		if (!Poco::File{pathObject}.exists() || !Poco::File{pathObject}.isFile())
+			return nullptr;
+
+		Poco::FileInputStream file{pathObject.toString(), std::ios::in | std::ios::binary};
+		std::string body{std::istreambuf_iterator<char>{file}, {}};
+
+		const auto mimeType = AssetCacheHelper::getMimeType(pathObject.getExtension());
+		auto asset = create(std::move(body), mimeType, "public, max-age=3600",
+			AssetCacheHelper::isCompressible(mimeType));
+
+		std::lock_guard<std::mutex> lock{mutex_};
+		assets_[path] = asset;
+		return asset;
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_error(MinerLogger::server, "Webserver could not open 'public/%s'!", path);
+		log_exception(MinerLogger::server, exc);
+		return nullptr;
+	}
+}
+
+std::shared_ptr<const Burst::Asset> Burst::AssetCache::create(std::string body, const std::string& mimeType,
+	const std::string& cacheControl, const bool compress)
+{
+	auto asset = std::make_shared<Asset>();
+	asset->mimeType = mimeType;
+	asset->cacheControl = cacheControl;
+	asset->etag = '"' + AssetCacheHelper::createEtag(body) + '"';
+
+	if (compress)
+	{
+		std::stringstream compressed;
+		Poco::DeflatingOutputStream deflater{compressed, Poco::DeflatingStreamBuf::STREAM_GZIP, 9};
+		deflater.write(body.data(), body.size());
+		deflater.close();
+
+		// the compressed version gets its own strong tag, because the bytes differ
+		if (compressed.str().size() < body.size())
+		{
+			asset->gzipBody = compressed.str();
+			asset->gzipEtag = asset->etag.substr(0, asset->etag.size() - 1) + "-gzip\"";
+		}
+	}
+
+	asset->body = std::move(body);
+	return asset;
+}
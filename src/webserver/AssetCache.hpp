@@ -0,0 +1,124 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <Poco/Types.h>
+
+namespace Poco
+{
+	namespace Net
+	{
+		class HTTPServerRequest;
+		class HTTPServerResponse;
+	}
+}
+
+namespace Burst
+{
+	struct TemplateVariables;
+
+	/**
+	 * \brief A file of the web UI, that is held in memory.
+	 * The instance is never changed after its creation, so it can be
+	 * shared between all webserver threads without locking.
+	 */
+	struct Asset
+	{
+		std::string mimeType;
+		std::string cacheControl;
+		std::string body;
+		// empty, if the file is not compressible
+		std::string gzipBody;
+		std::string etag, gzipEtag;
+
+		/**
+		 * \brief Sends the asset as response.
+		 * The gzip version is sent, if the client accepts it, and a matching If-None-Match is answered with 304.
+		 * \param request The HTTP request.
+		 * \param response The HTTP response.
+		 */
+		void send(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response) const;
+	};
+
+	/**
+	 * \brief Holds all files of the web UI and the rendered templates in memory.
+	 * The files are read and compressed once, the templates are rendered again
+	 * only after they were invalidated (config change) or the plot files changed.
+	 */
+	class AssetCache
+	{
+	public:
+		explicit AssetCache(std::string root = "public");
+
+		/**
+		 * \brief Reads all files below the root directory.
+		 */
+		void load();
+
+		/**
+		 * \brief Returns a file of the web UI.
+		 * Files, that were added after load(), are read on their first request.
+		 * \param path The path of the file, relative to the root directory.
+		 * \return The file or nullptr, if it does not exist.
+		 */
+		std::shared_ptr<const Asset> get(const std::string& path);
+
+		/**
+		 * \brief Returns a rendered template.
+		 * \param templatePage The template page.
+		 * \param contentPage The content page, that is inserted into the template.
+		 * \param variables The variables, that are inserted into template and content page.
+		 * Their values are only evaluated, when the template is rendered.
+		 * \return The rendered page or nullptr, if one of the pages does not exist.
+		 */
+		std::shared_ptr<const Asset> getTemplate(const std::string& templatePage, const std::string& contentPage,
+			const TemplateVariables& variables);
+
+		/**
+		 * \brief Marks all rendered templates as outdated.
+		 */
+		void invalidateTemplates();
+
+	private:
+		std::shared_ptr<const Asset> loadFile(const std::string& path);
+		static std::shared_ptr<const Asset> create(std::string body, const std::string& mimeType,
+			const std::string& cacheControl, bool compress);
+
+		struct RenderedTemplate
+		{
+			Poco::UInt64 version;
+			std::string plotsHash;
+			std::shared_ptr<const Asset> asset;
+		};
+
+		std::string root_;
+		std::unordered_map<std::string, std::shared_ptr<const Asset>> assets_;
+		std::unordered_map<std::string, RenderedTemplate> templates_;
+		std::atomic<Poco::UInt64> templateVersion_{0};
+		std::mutex mutex_;
+	};
+}
@@ -38,6 +38,7 @@
 #include <Poco/Delegate.h>
 #include <Poco/Exception.h>
 #include <Poco/Net/SecureServerSocket.h>
+#include <Poco/NumberParser.h>
 
 using namespace Poco;
 using namespace Net;
@@ -68,6 +69,9 @@ void Burst::MinerServer::run(uint16_t port)
 	
 	port_ = port;
 
+	// the web files are read and compressed once, not with every request
+	assets_.load();
+
 	std::unique_ptr<ServerSocket> socket;
 
 	if (MinerConfig::getConfig().getServerCertificatePath().empty())
@@ -142,13 +146,31 @@ void Burst::MinerServer::connectToMinerData(MinerData& minerData)
 	}
 }
 
-void Burst::MinerServer::sendToWebsockets(std::string& data)
+void Burst::MinerServer::addDownstreamSubmission(bool forwarded)
+{
+	if (forwarded)
+		++upstreamSubmissions_;
+	else
+		++upstreamSubmissionsSaved_;
+}
+
+Poco::UInt64 Burst::MinerServer::getUpstreamSubmissions() const
+{
+	return upstreamSubmissions_.load();
+}
+
+Poco::UInt64 Burst::MinerServer::getUpstreamSubmissionsSaved() const
+{
+	return upstreamSubmissionsSaved_.load();
+}
+
+void Burst::MinerServer::sendToWebsockets(std::string data)
 {
 	poco_ndc(MinerServer::sendToWebsockets);
-	ScopedLock<Mutex> lock{mutex_};
+
 	try
 	{
-		newDataEvent(this, data);
+		websockets_.broadcast(std::move(data));
 	}
 	catch (const Exception& e)
 	{
@@ -165,8 +187,21 @@ void Burst::MinerServer::sendToWebsockets(const JSON::Object& json)
 	{
 		std::stringstream sstream;
 		json.stringify(sstream);
-		auto jsonString = sstream.str();
-		sendToWebsockets(jsonString);
+
+		// a client only needs the newest progress, so older ones are replaced in its queue
+		std::string key;
+
+		if (json.has("type"))
+		{
+			const auto type = json.get("type").toString();
+
+			if (type == "progress")
+				key = type;
+			else if (type == "plotdir-progress" && json.has("dir"))
+				key = type + ":" + json.get("dir").toString();
+		}
+
+		websockets_.broadcast(sstream.str(), std::move(key));
 	}
 	catch (const Poco::Exception& e)
 	{
@@ -175,6 +210,16 @@ void Burst::MinerServer::sendToWebsockets(const JSON::Object& json)
 	}
 }
 
+Burst::WebsocketBroadcaster& Burst::MinerServer::getWebsocketBroadcaster()
+{
+	return websockets_;
+}
+
+Burst::AssetCache& Burst::MinerServer::getAssetCache()
+{
+	return assets_;
+}
+
 void Burst::MinerServer::onMinerDataChangeEvent(const void* sender, const Poco::JSON::Object& data)
 {
 	poco_ndc(MinerServer::onMinerDataChangeEvent);
@@ -190,6 +235,8 @@ void Burst::MinerServer::onMinerDataChangeEvent(const void* sender, const Poco::
 			const auto progressRead = data.get("value").extract<float>();
 			const auto progressVerification = data.get("valueVerification").extract<float>();
 
+			ScopedLock<FastMutex> lock{progressMutex_};
+
 			send = static_cast<int>(progressRead) != static_cast<int>(progressRead_) ||
 				static_cast<int>(progressVerification) != static_cast<int>(progressVerification_);
 			
@@ -251,7 +298,7 @@ HTTPRequestHandler* Burst::MinerServer::RequestFactory::createRequestHandler(con
 				auto variables = server_->variables_ + TemplateVariables({
 					{"includes", []() { return std::string("<script src='js/block.js'></script>"); }}
 				});
-				RequestHandler::loadSecuredTemplate(req, res, "index.html", "block.html", variables);
+				RequestHandler::loadSecuredTemplate(req, res, server_->assets_, "index.html", "block.html", variables);
 			});
 
 		// plotfiles
@@ -277,7 +324,7 @@ HTTPRequestHandler* Burst::MinerServer::RequestFactory::createRequestHandler(con
 					}
 				});
 
-				RequestHandler::loadSecuredTemplate(req, res, "index.html", "plotfiles.html", variables);
+				RequestHandler::loadSecuredTemplate(req, res, server_->assets_, "index.html", "plotfiles.html", variables);
 			});
 		}
 
@@ -300,6 +347,7 @@ HTTPRequestHandler* Burst::MinerServer::RequestFactory::createRequestHandler(con
 			return new LambdaRequestHandler([&](ReqT& req, ResT& res)
 			{
 				RequestHandler::rescanPlotfiles(req, res, *server_->miner_);
+				server_->assets_.invalidateTemplates();
 			});
 
 		// show/change settings
@@ -312,7 +360,7 @@ HTTPRequestHandler* Burst::MinerServer::RequestFactory::createRequestHandler(con
 					auto variables = server_->variables_ + TemplateVariables({
 						{"includes", []() { return std::string("<script src='js/settings.js'></script>"); }}
 					});
-					RequestHandler::loadSecuredTemplate(req, res, "index.html", "settings.html", variables);
+					RequestHandler::loadSecuredTemplate(req, res, server_->assets_, "index.html", "settings.html", variables);
 				});
 
 			// with body -> change
@@ -320,6 +368,7 @@ HTTPRequestHandler* Burst::MinerServer::RequestFactory::createRequestHandler(con
 				return new LambdaRequestHandler([&](ReqT& req, ResT& res)
 				{
 					RequestHandler::changeSettings(req, res, *server_->miner_);
+					server_->assets_.invalidateTemplates();
 				});
 		}
 
@@ -363,10 +412,47 @@ HTTPRequestHandler* Burst::MinerServer::RequestFactory::createRequestHandler(con
 				else
 				{
 					auto variables = server_->variables_ + TemplateVariables({{"includes", []() { return std::string(); }}});
-					RequestHandler::loadTemplate(req, res, "index.html", "login.html", variables);
+					RequestHandler::loadTemplate(req, res, server_->assets_, "index.html", "login.html", variables);
 				}
 			});
 
+		// read throughput of the plot dirs
+		if (pathSegments.front() == "disks")
+			return new LambdaRequestHandler([&](ReqT& req, ResT& res)
+			{
+				RequestHandler::diskHealth(req, res, *server_->miner_);
+			});
+
+		// paginated history of the mined blocks and the compacted days
+		if (pathSegments.front() == "history")
+		{
+			const auto daily = pathSegments.size() > 1 && pathSegments[1] == "daily";
+
+			return new LambdaRequestHandler([&, daily](ReqT& req, ResT& res)
+			{
+				RequestHandler::history(req, res, *server_->miner_, daily);
+			});
+		}
+
+		// metrics for monitoring
+		if (pathSegments.front() == "metrics")
+			return new LambdaRequestHandler([&](ReqT& req, ResT& res)
+			{
+				RequestHandler::metrics(req, res, *server_);
+			});
+
+		// timeline of a round
+		if (pathSegments.front() == "timeline" && pathSegments.size() > 1)
+		{
+			Poco::UInt64 blockheight;
+
+			if (NumberParser::tryParseUnsigned64(pathSegments[1], blockheight))
+				return new LambdaRequestHandler([&, blockheight](ReqT& req, ResT& res)
+				{
+					RequestHandler::roundTimeline(req, res, *server_->miner_, blockheight);
+				});
+		}
+
 		if (pathSegments.front() == "logout")
 			return new LambdaRequestHandler([&](ReqT& req, ResT& res) { RequestHandler::logout(req, res); });
 
@@ -398,11 +484,11 @@ HTTPRequestHandler* Burst::MinerServer::RequestFactory::createRequestHandler(con
 			});
 		}
 
-		Path path{"public"};
-		path.append(uri.getPath());
-
-		if (File{path}.exists())
-			return new LambdaRequestHandler(RequestHandler::loadAsset);
+		if (server_->assets_.get(uri.getPath()) != nullptr)
+			return new LambdaRequestHandler([&](ReqT& req, ResT& res)
+			{
+				RequestHandler::loadAsset(req, res, server_->assets_);
+			});
 
 		return new LambdaRequestHandler(RequestHandler::notFound);
 	}
@@ -22,8 +22,11 @@
 #pragma once
 
 #include <memory>
+#include <atomic>
 #include <Poco/Net/HTTPRequestHandlerFactory.h>
 #include "RequestHandler.hpp"
+#include "WebsocketBroadcaster.hpp"
+#include "AssetCache.hpp"
 
 namespace Poco
 {
@@ -57,10 +60,19 @@ namespace Burst
 		void stop();
 		
 		void connectToMinerData(MinerData& minerData);
-		void sendToWebsockets(std::string& data);
+		void sendToWebsockets(std::string data);
 		void sendToWebsockets(const Poco::JSON::Object& json);
+		WebsocketBroadcaster& getWebsocketBroadcaster();
+		AssetCache& getAssetCache();
 
-		Poco::BasicEvent<std::string> newDataEvent;
+		/**
+		 * \brief Counts a nonce submission of a downstream miner.
+		 * \param forwarded True, if the nonce was forwarded to the pool,
+		 * false, if it was answered locally because a better deadline was already forwarded.
+		 */
+		void addDownstreamSubmission(bool forwarded);
+		Poco::UInt64 getUpstreamSubmissions() const;
+		Poco::UInt64 getUpstreamSubmissionsSaved() const;
 
 	private:
 		void onMinerDataChangeEvent(const void* sender, const Poco::JSON::Object& data);
@@ -69,10 +81,13 @@ namespace Burst
 		MinerData* minerData_;
 		uint16_t port_;
 		std::unique_ptr<Poco::Net::HTTPServer> server_;
-		Poco::Mutex mutex_;
+		Poco::FastMutex progressMutex_;
+		WebsocketBroadcaster websockets_;
+		AssetCache assets_;
 		TemplateVariables variables_;
 		Poco::ThreadPool threadPool_;
 		float progressRead_ = 0.f, progressVerification_ = 0.f;
+		std::atomic<Poco::UInt64> upstreamSubmissions_{0}, upstreamSubmissionsSaved_{0};
 
 		struct RequestFactory : Poco::Net::HTTPRequestHandlerFactory
 		{
@@ -0,0 +1,72 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "MiningInfoCache.hpp"
+#include "mining/Miner.hpp"
+#include "mining/MinerConfig.hpp"
+#include <Poco/JSON/Object.h>
+#include <Poco/Format.h>
+#include <sstream>
+
+std::shared_ptr<const Burst::MiningInfoResponse> Burst::MiningInfoCache::get(const Miner& miner)
+{
+	const auto version = version_.load();
+	auto response = std::atomic_load(&response_);
+
+	if (response != nullptr && response->version == version)
+		return response;
+
+	// if the cache gets invalidated while we are building the response,
+	// the stored version is already outdated and the next call builds it again
+	response = create(miner, version);
+	std::atomic_store(&response_, response);
+	return response;
+}
+
+void Burst::MiningInfoCache::invalidate()
+{
+	++version_;
+}
+
+std::shared_ptr<const Burst::MiningInfoResponse> Burst::MiningInfoCache::create(const Miner& miner, Poco::UInt64 version)
+{
+	const auto height = miner.getBlockheight();
+	const auto baseTarget = miner.getBaseTarget();
+	const auto gensig = miner.getGensigStr();
+	const auto targetDeadline = MinerConfig::getConfig().getSnapshot()->getTargetDeadline();
+
+	Poco::JSON::Object json;
+	json.set("baseTarget", std::to_string(baseTarget));
+	json.set("generationSignature", gensig);
+	json.set("targetDeadline", targetDeadline);
+	json.set("height", height);
+
+	std::stringstream ss;
+	json.stringify(ss);
+
+	auto response = std::make_shared<MiningInfoResponse>();
+	response->version = version;
+	response->height = height;
+	response->body = ss.str();
+	// the gensig already identifies the block, height and target deadline make the tag readable
+	response->etag = Poco::format("\"%Lu-%s-%Lu\"", height, gensig.substr(0, 16), targetDeadline);
+	return response;
+}
@@ -0,0 +1,74 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <memory>
+#include <atomic>
+#include <string>
+#include <Poco/Types.h>
+
+namespace Burst
+{
+	class Miner;
+
+	/**
+	 * \brief A serialized getMiningInfo response.
+	 * The instance is never changed after its creation, so it can be
+	 * shared between all webserver threads without locking.
+	 */
+	struct MiningInfoResponse
+	{
+		Poco::UInt64 version;
+		Poco::UInt64 height;
+		std::string body;
+		std::string etag;
+	};
+
+	/**
+	 * \brief Holds the serialized getMiningInfo response for the current block.
+	 * The response is only rebuilt when the cache got invalidated (new block, new target deadline),
+	 * every other request only loads the shared pointer.
+	 */
+	class MiningInfoCache
+	{
+	public:
+		/**
+		 * \brief Returns the serialized mining info.
+		 * If the cache was invalidated since the last call, the response is rebuilt.
+		 * \param miner The miner instance, from which the mining info is gathered.
+		 * \return The current response, never nullptr.
+		 */
+		std::shared_ptr<const MiningInfoResponse> get(const Miner& miner);
+
+		/**
+		 * \brief Marks the cached response as outdated.
+		 * The next call of get() will rebuild it.
+		 */
+		void invalidate();
+
+	private:
+		static std::shared_ptr<const MiningInfoResponse> create(const Miner& miner, Poco::UInt64 version);
+
+		std::atomic<Poco::UInt64> version_{0};
+		std::shared_ptr<const MiningInfoResponse> response_;
+	};
+}
@@ -20,6 +20,7 @@
 // ==========================================================================
 
 #include "RequestHandler.hpp"
+#include "AssetCache.hpp"
 #include <Poco/Net/WebSocket.h>
 #include <Poco/Net/HTTPResponse.h>
 #include <Poco/Net/HTTPServerRequest.h>
@@ -46,6 +47,12 @@
 #include <Poco/Delegate.h>
 #include "plots/Plot.hpp"
 #include <Poco/Net/HTTPRequest.h>
+#include <Poco/URI.h>
+#include "logging/Metrics.hpp"
+#include "plots/PlotReader.hpp"
+#include "mining/Numa.hpp"
+#include <limits>
+#include <algorithm>
 
 const std::string cookieUserName = "creepminer-webserver-user";
 const std::string cookiePassName = "creepminer-webserver-pass";
@@ -91,30 +98,18 @@ Burst::RequestHandler::WebsocketRequestHandler::WebsocketRequestHandler(MinerSer
 {
 	poco_ndc(WebsocketRequestHandler::WebSocketRequestHandler);
 
-	try
-	{
-		server_.newDataEvent += Poco::delegate(this, &WebsocketRequestHandler::onNewData);
-	}
-	catch (const Poco::Exception& e)
-	{
-		log_error(MinerLogger::server, "Could not connect to server_.newDataEvent: %s", e.displayText());
-		log_current_stackframe(MinerLogger::server);
-	}
+	// subscribe before the initial data is sent, so no broadcast is missed
+	queue_ = server_.getWebsocketBroadcaster().subscribe();
 }
 
 Burst::RequestHandler::WebsocketRequestHandler::~WebsocketRequestHandler()
 {
 	poco_ndc(WebsocketRequestHandler::~WebsocketRequestHandler);
 
-	try
-	{
-		server_.newDataEvent -= Poco::delegate(this, &WebsocketRequestHandler::onNewData);
-	}
-	catch (const Poco::Exception& e)
-	{
-		log_error(MinerLogger::server, "Could not disconnect to server_.newDataEvent: %s", e.displayText());
-		log_current_stackframe(MinerLogger::server);
-	}
+	server_.getWebsocketBroadcaster().unsubscribe(queue_);
+
+	if (queue_->getDropped() > 0)
+		log_debug(MinerLogger::server, "Websocket client dropped %Lu messages", queue_->getDropped());
 }
 
 void Burst::RequestHandler::WebsocketRequestHandler::handleRequest(Poco::Net::HTTPServerRequest& request,
@@ -160,30 +155,31 @@ void Burst::RequestHandler::WebsocketRequestHandler::handleRequest(Poco::Net::HT
 		int flags = 0;
 		auto close = false;
 		ws.setReceiveTimeout(Timespan{1, 0}); // 1 s
-		const auto sleepTime = std::chrono::milliseconds{10};
+		const auto waitTime = std::chrono::milliseconds{10};
+		std::vector<WebsocketMessagePtr> messages;
 
-		const auto send = [&]()
+		// sends everything, that was queued since the last call, without holding any lock
+		const auto send = [&](const std::chrono::milliseconds timeout)
 		{
-			if (!close)
+			if (close || !queue_->pop(messages, timeout))
+				return;
+
+			for (const auto& message : messages)
 			{
-				std::lock_guard<std::mutex> lock(mutex_);
-				if (!queue_.empty())
-				{
-					auto data = queue_.front();
-					queue_.pop_front();
-					const auto s = ws.sendFrame(data.data(), static_cast<int>(data.size()));
-					if (s != static_cast<int>(data.size()))
-						log_warning(MinerLogger::server, "Could not fully send: %s", data);
-				}
+				const auto& data = message->data;
+				const auto s = ws.sendFrame(data.data(), static_cast<int>(data.size()));
+				if (s != static_cast<int>(data.size()))
+					log_warning(MinerLogger::server, "Could not fully send: %s", data);
 			}
+
+			messages.clear();
 		};
 
 		do
 		{
 			if (ws.available() == 0)
 			{
-				send();
-				std::this_thread::sleep_for(sleepTime);
+				send(waitTime);
 				continue;
 			}
 
@@ -201,7 +197,7 @@ void Burst::RequestHandler::WebsocketRequestHandler::handleRequest(Poco::Net::HT
 				close = true;
 			}
 
-			send();
+			send(std::chrono::milliseconds{0});
 		}
 		while (!close && (flags & WebSocket::FRAME_OP_BITMASK) != WebSocket::FRAME_OP_CLOSE);
 		ws.shutdown();
@@ -212,133 +208,54 @@ void Burst::RequestHandler::WebsocketRequestHandler::handleRequest(Poco::Net::HT
 	}
 }
 
-void Burst::RequestHandler::WebsocketRequestHandler::onNewData(std::string& data)
-{
-	std::lock_guard<std::mutex> lock(mutex_);
-
-	poco_ndc(WebsocketRequestHandler::onNewData);
-
-	try
-	{
-		queue_.emplace_back(data);
-	}
-	catch (const Poco::Exception& e)
-	{
-		log_error(MinerLogger::server, "Could not enqueue new data for websockets: %s", e.displayText());
-		log_current_stackframe(MinerLogger::server);
-	}
-}
-
 void Burst::RequestHandler::loadTemplate(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response,
-	const std::string& templatePage, const std::string& contentPage, TemplateVariables& variables)
+	AssetCache& assets, const std::string& templatePage, const std::string& contentPage, TemplateVariables& variables)
 {
-	Poco::FileInputStream fileIndex, fileContent;
-	std::string output;
-
-	// open the index page 
-	try
-	{
-		// open the template file 
-		fileIndex.open("public/" + templatePage, std::ios::in);
-		// read the content of the file and load it into a string 
-		output = std::string{ std::istreambuf_iterator<char>{fileIndex},{} };
-	}
-	catch (Poco::Exception& exc)
-	{
-		log_error(MinerLogger::server, "Could not open public/index.html!");
-		log_exception(MinerLogger::server, exc);
-
-		if (fileIndex)
-			fileIndex.close();
-
-		return notFound(request, response);
-	}
-
-	// open the embedded page 
-	try
-	{
-		// load it into a string 
-		fileContent.open("public/" + contentPage, std::ios::in);
-		std::string strContent(std::istreambuf_iterator<char>{fileContent}, {});
-
-		// replace variables inside it 
-		TemplateVariables contentFramework;
-		contentFramework.variables.emplace("content", [&strContent]() { return strContent; });
-
-		contentFramework.inject(output);
-		variables.inject(output);
-	}
-	catch (Poco::Exception& exc)
-	{
-		log_error(MinerLogger::server, "Could not open 'public/%s'!", contentPage);
-		log_exception(MinerLogger::server, exc);
-
-		if (fileContent)
-			fileContent.close();
+	const auto page = assets.getTemplate(templatePage, contentPage, variables);
 
+	if (page == nullptr)
 		return notFound(request, response);
-	}
 
-	// not necessary, but good style 
-	fileIndex.close();
-	fileContent.close();
-
-	response.setStatus(Poco::Net::HTTPResponse::HTTP_OK);
-	response.setChunkedTransferEncoding(true);
-	
-	auto& responseStream = response.send();
-	responseStream << output << std::flush;
+	page->send(request, response);
 }
 
 void Burst::RequestHandler::loadSecuredTemplate(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response,
-	const std::string& templatePage, const std::string& contentPage, TemplateVariables& variables)
+	AssetCache& assets, const std::string& templatePage, const std::string& contentPage, TemplateVariables& variables)
 {
 	if (!checkCredentials(request, response))
 		return;
 
-	loadTemplate(request, response, templatePage, contentPage, variables);
+	loadTemplate(request, response, assets, templatePage, contentPage, variables);
 }
 
-bool Burst::RequestHandler::loadAssetByPath(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response, const std::string& path)
+bool Burst::RequestHandler::loadAssetByPath(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response,
+	AssetCache& assets, const std::string& path)
 {
 	try
 	{
-		Poco::Path pathObject{ "public/" + path };
-		Poco::FileInputStream file{ pathObject.toString(), std::ios::in };
-		const std::string str(std::istreambuf_iterator<char>{file}, {});
+		const auto asset = assets.get(path);
 
-		std::string mimeType = "text/plain";
-
-		const auto ext = pathObject.getExtension();
-
-		if (ext == "css")
-			mimeType = "text/css";
-		else if (ext == "js")
-			mimeType = "text/javascript";
-		else if (ext == "png")
-			mimeType = "image/png";
-		//else if (ext == "html")
-		//	mimeType = "text/html; charset=utf-8";
-
-		response.setStatus(Poco::Net::HTTPResponse::HTTP_OK);
-		response.setChunkedTransferEncoding(true);
-		response.setContentType(mimeType);
-		auto& out = response.send();
+		if (asset == nullptr)
+		{
+			notFound(request, response);
+			return false;
+		}
 
-		out << str;
+		asset->send(request, response);
 		return true;
 	}
 	catch (Poco::Exception& exc)
 	{
-		log_error(MinerLogger::server, "Webserver could not open 'public/%s'!", request.getURI());
+		log_error(MinerLogger::server, "Webserver could not send 'public/%s'!", path);
 		log_exception(MinerLogger::server, exc);
 		return false;
 	}
 }
 
-bool Burst::RequestHandler::loadAsset(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response)
+bool Burst::RequestHandler::loadAsset(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response,
+	AssetCache& assets)
 {
-	return loadAssetByPath(request, response, request.getURI());
+	return loadAssetByPath(request, response, assets, Poco::URI{request.getURI()}.getPath());
 }
 
 namespace Burst
@@ -766,13 +683,31 @@ void Burst::RequestHandler::submitNonce(Poco::Net::HTTPServerRequest& request, P
 		{
 			poco_ndc(SubmitNonceHandler::handleRequest::forwarding);
 			log_information(MinerLogger::server, deadline.toActionString("forwarding nonce"));
-			NonceConfirmation confirmation;
+			NonceConfirmation confirmation{0, SubmitResponse::None, "", 0, ""};
 			const auto addedDeadline = miner.addDeadline(std::move(deadline), confirmation);
+
+			// only strict improvements for an account are forwarded to the pool,
+			// all other downstream miners get their answer immediately
 			if (addedDeadline != nullptr)
+			{
+				server.addDownstreamSubmission(true);
 				confirmation = miner.submitDeadline(addedDeadline);
-			else
-				confirmation = NonceConfirmation::createSuccess(deadline.getNonce(), deadline.getDeadline(),
-				                                                deadline.deadlineToReadableString());
+			}
+			else if (confirmation.errorCode == SubmitResponse::None)
+				server.addDownstreamSubmission(false);
+
+			// the answer of the pool is passed through, only a deadline that was not added is answered locally
+			if (addedDeadline == nullptr &&
+				(confirmation.errorCode == SubmitResponse::None ||
+					(confirmation.errorCode == SubmitResponse::NotBest && confirmation.json.empty())))
+			{
+				const auto best = miner.getBestFound(accountId, blockheight);
+				confirmation = NonceConfirmation::createNotBest(nonce, deadlineValue,
+				                                                best == nullptr ? 0 : best->getDeadline());
+				log_debug(MinerLogger::server, "Nonce %Lu of account %Lu answered locally (not best), %Lu upstream submissions saved so far",
+					nonce, accountId, server.getUpstreamSubmissionsSaved());
+			}
+
 			response.setStatus(Poco::Net::HTTPResponse::HTTP_OK);
 			response.setContentLength(confirmation.json.size());
 			auto& responseData = response.send();
@@ -803,21 +738,25 @@ void Burst::RequestHandler::miningInfo(Poco::Net::HTTPServerRequest& request, Po
 
 	try
 	{
-		Poco::JSON::Object json;
-		json.set("baseTarget", std::to_string(miner.getBaseTarget()));
-		json.set("generationSignature", miner.getGensigStr());
-		json.set("targetDeadline", MinerConfig::getConfig().getTargetDeadline());
-		json.set("height", miner.getBlockheight());
+		const auto miningInfo = miner.getMiningInfoCache().get(miner);
 
-		std::stringstream ss;
-		json.stringify(ss);
-		auto jsonStr = ss.str();
+		response.set("ETag", miningInfo->etag);
+
+		// the client already has the current mining info
+		if (request.get("If-None-Match", "") == miningInfo->etag)
+		{
+			response.setStatus(Poco::Net::HTTPResponse::HTTP_NOT_MODIFIED);
+			response.setContentLength(0);
+			response.send();
+			return;
+		}
 
 		response.setStatus(Poco::Net::HTTPResponse::HTTP_OK);
-		response.setContentLength(jsonStr.size());
+		response.setContentType("application/json");
+		response.setContentLength(miningInfo->body.size());
 
 		auto& output = response.send();
-		output << jsonStr;
+		output << miningInfo->body;
 	}
 	catch (Poco::Exception& exc)
 	{
@@ -826,6 +765,207 @@ void Burst::RequestHandler::miningInfo(Poco::Net::HTTPServerRequest& request, Po
 	}
 }
 
+void Burst::RequestHandler::roundTimeline(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response,
+	Miner& miner, const Poco::UInt64 blockheight)
+{
+	poco_ndc(RequestHandler::roundTimeline);
+
+	try
+	{
+		std::string timeline;
+		const auto block = miner.getData().getBlockData();
+
+		if (block != nullptr && block->getBlockheight() == blockheight)
+			timeline = jsonToString(block->getTimeline().toJSON(blockheight));
+		else if (!miner.getData().getRoundTimeline(blockheight, timeline))
+			return notFound(request, response);
+
+		response.setStatus(Poco::Net::HTTPResponse::HTTP_OK);
+		response.setContentType("application/json");
+		response.setContentLength(timeline.size());
+
+		auto& output = response.send();
+		output << timeline;
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_error(MinerLogger::server, "Webserver could not send the round timeline! %s", exc.displayText());
+		log_current_stackframe(MinerLogger::server);
+	}
+}
+
+void Burst::RequestHandler::diskHealth(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response,
+	Miner& miner)
+{
+	poco_ndc(RequestHandler::diskHealth);
+
+	try
+	{
+		Poco::UInt64 rounds = 100;
+		Poco::Net::HTMLForm form{request};
+
+		if (form.has("rounds"))
+			rounds = Poco::NumberParser::parseUnsigned64(form.get("rounds"));
+
+		Poco::JSON::Object json;
+		json.set("devices", miner.getData().getDiskHealth().toJSON());
+
+		if (Numa::isActive())
+			json.set("nodes", miner.getData().getDiskHealth().nodesToJSON());
+
+		json.set("history", miner.getData().getReadThroughputHistory(rounds));
+
+		const auto body = jsonToString(json);
+
+		response.setStatus(Poco::Net::HTTPResponse::HTTP_OK);
+		response.setContentType("application/json");
+		response.setContentLength(body.size());
+
+		auto& output = response.send();
+		output << body;
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_error(MinerLogger::server, "Webserver could not send the disk health! %s", exc.displayText());
+		log_current_stackframe(MinerLogger::server);
+	}
+}
+
+void Burst::RequestHandler::history(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response,
+	Miner& miner, const bool daily)
+{
+	poco_ndc(RequestHandler::history);
+
+	try
+	{
+		// sqlite stores signed integers
+		Poco::UInt64 cursor = std::numeric_limits<Poco::Int64>::max();
+		Poco::UInt64 limit = 100;
+		Poco::Net::HTMLForm form{request};
+
+		if (form.has("cursor"))
+			cursor = std::min(cursor, Poco::NumberParser::parseUnsigned64(form.get("cursor")));
+
+		if (form.has("limit"))
+			limit = std::max<Poco::UInt64>(1, std::min<Poco::UInt64>(1000, Poco::NumberParser::parseUnsigned64(form.get("limit"))));
+
+		response.setStatus(Poco::Net::HTTPResponse::HTTP_OK);
+		response.setContentType("application/json");
+		response.setChunkedTransferEncoding(true);
+
+		auto& output = response.send();
+		Poco::UInt64 count = 0, next = 0;
+
+		// every entry is written on its own, so the page is never built as a whole
+		const auto writeEntry = [&](const Poco::JSON::Object& entry, const Poco::UInt64 entryCursor)
+		{
+			if (count++ > 0)
+				output << ',';
+
+			entry.stringify(output);
+			next = entryCursor;
+		};
+
+		output << "{\"type\":\"" << (daily ? "daily history" : "history") << "\",\"entries\":[";
+
+		if (daily)
+		{
+			for (const auto& summary : miner.getData().getDailySummaries(cursor, limit))
+			{
+				Poco::JSON::Object json;
+				json.set("day", summary.day);
+				json.set("fromHeight", summary.fromHeight);
+				json.set("toHeight", summary.toHeight);
+				json.set("blocks", summary.blocks);
+				json.set("minDifficulty", summary.minDifficulty);
+				json.set("maxDifficulty", summary.maxDifficulty);
+				json.set("meanRoundTime", summary.roundTimeSum / static_cast<double>(summary.blocks));
+				json.set("meanBlockTime", summary.blockTimeSum / static_cast<double>(summary.blocks));
+				json.set("deadlinesConfirmed", summary.confirmedDeadlines);
+
+				if (summary.confirmedDeadlines > 0)
+				{
+					json.set("deadlinesAvg", summary.deadlineSum / summary.confirmedDeadlines);
+					json.set("bestDeadline", summary.bestDeadline);
+				}
+
+				writeEntry(json, summary.day);
+			}
+		}
+		else
+		{
+			for (const auto& entry : miner.getData().getHistory(cursor, limit))
+			{
+				Poco::JSON::Object json;
+				json.set("height", entry.height);
+				json.set("baseTarget", entry.baseTarget);
+				json.set("difficulty", entry.difficulty);
+				json.set("roundTime", entry.roundTime);
+				json.set("blockTime", entry.blockTime);
+				json.set("deadlinesConfirmed", entry.confirmedDeadlines);
+
+				if (entry.confirmedDeadlines > 0)
+					json.set("bestDeadline", entry.bestDeadline);
+
+				writeEntry(json, entry.height);
+			}
+		}
+
+		output << ']';
+
+		// a full page could be followed by more entries
+		if (count == limit && next > 0)
+			output << ",\"nextCursor\":" << next;
+
+		output << '}';
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_error(MinerLogger::server, "Webserver could not send the history! %s", exc.displayText());
+		log_current_stackframe(MinerLogger::server);
+	}
+}
+
+void Burst::RequestHandler::metrics(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response,
+	MinerServer& server)
+{
+	poco_ndc(RequestHandler::metrics);
+
+	try
+	{
+		std::stringstream sstr;
+
+		sstr << Metrics::toPrometheus();
+
+		sstr << "# HELP creepminer_buffer_used_bytes Memory of the buffer pool in use\n";
+		sstr << "# TYPE creepminer_buffer_used_bytes gauge\n";
+		sstr << "creepminer_buffer_used_bytes " << PlotReader::globalBufferSize.getSize() << '\n';
+		sstr << "# HELP creepminer_buffer_max_bytes Size of the buffer pool\n";
+		sstr << "# TYPE creepminer_buffer_max_bytes gauge\n";
+		sstr << "creepminer_buffer_max_bytes " << PlotReader::globalBufferSize.getMax() << '\n';
+		sstr << "# HELP creepminer_upstream_submissions_total Downstream submissions forwarded to the pool\n";
+		sstr << "# TYPE creepminer_upstream_submissions_total counter\n";
+		sstr << "creepminer_upstream_submissions_total " << server.getUpstreamSubmissions() << '\n';
+		sstr << "# HELP creepminer_upstream_submissions_saved_total Downstream submissions answered without the pool\n";
+		sstr << "# TYPE creepminer_upstream_submissions_saved_total counter\n";
+		sstr << "creepminer_upstream_submissions_saved_total " << server.getUpstreamSubmissionsSaved() << '\n';
+
+		const auto metrics = sstr.str();
+
+		response.setStatus(Poco::Net::HTTPResponse::HTTP_OK);
+		response.setContentType("text/plain; version=0.0.4");
+		response.setContentLength(metrics.size());
+
+		auto& output = response.send();
+		output << metrics;
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_error(MinerLogger::server, "Webserver could not send the metrics! %s", exc.displayText());
+		log_current_stackframe(MinerLogger::server);
+	}
+}
+
 void Burst::RequestHandler::changeSettings(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response,
 	Miner& miner)
 {
@@ -871,7 +1011,10 @@ void Burst::RequestHandler::changeSettings(Poco::Net::HTTPServerRequest& request
 					else if (key == "max-historical-blocks")
 						MinerConfig::getConfig().setMaxHistoricalBlocks(np::parseUnsigned(value));
 					else if (key == "target-deadline")
+					{
 						MinerConfig::getConfig().setTargetDeadline(value, TargetDeadlineType::Local);
+						miner.getMiningInfoCache().invalidate();
+					}
 					else if (key == "timeout")
 						MinerConfig::getConfig().setTimeout(static_cast<float>(np::parseFloat(value)));
 					else if (key == "log-dir")
@@ -974,6 +1117,7 @@ void Burst::RequestHandler::changePlotDirs(Poco::Net::HTTPServerRequest& request
 				else
 				{
 					server.sendToWebsockets(createJsonPlotDirsRescan());
+					server.getAssetCache().invalidateTemplates();
 					MinerConfig::getConfig().printConsolePlots();
 					MinerConfig::getConfig().printBufferSize();
 				}
@@ -29,6 +29,7 @@
 #include "mining/MinerConfig.hpp"
 #include <stack>
 #include <mutex>
+#include "WebsocketBroadcaster.hpp"
 
 namespace Poco
 {
@@ -47,6 +48,7 @@ namespace Burst
 {
 	class Miner;
 	class MinerServer;
+	class AssetCache;
 
 	/**
 	 * \brief This class holds key value pairs (string -> string)
@@ -112,25 +114,24 @@ namespace Burst
 			void handleRequest(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response) override;
 
 		private:
-			void onNewData(std::string& data);
-
-		private:
-			std::mutex mutex_;
 			MinerServer& server_;
 			MinerData& data_;
-			std::deque<std::string> queue_;
+			// filled by the broadcaster, drained by the connection thread
+			std::shared_ptr<WebsocketQueue> queue_;
 		};
 
 		/**
 		 * \brief Loads a template and fills it with content.
+		 * The rendered template is cached until the templates are invalidated.
 		 * \param request The HTTP request.
 		 * \param response The HTTP response.
+		 * \param assets The cache of the web files.
 		 * \param templatePage The template page.
 		 * \param contentPage The content page, that is inserted into the template.
 		 * \param variables The variables, that are inserted into template and contentpage.
 		 */
 		void loadTemplate(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response,
-		                  const std::string& templatePage, const std::string& contentPage,
+		                  AssetCache& assets, const std::string& templatePage, const std::string& contentPage,
 		                  TemplateVariables& variables);
 
 		/**
@@ -138,31 +139,35 @@ namespace Burst
 		 * The template is only send as response, when the user is logged in.
 		 * \param request The HTTP request.
 		 * \param response The HTTP response.
+		 * \param assets The cache of the web files.
 		 * \param templatePage The template page.
 		 * \param contentPage The content page, that is inserted into the template.
 		 * \param variables The variables, that are inserted into template and contentpage.
 		 */
 		void loadSecuredTemplate(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response,
-								 const std::string& templatePage, const std::string& contentPage,
+								 AssetCache& assets, const std::string& templatePage, const std::string& contentPage,
 								 TemplateVariables& variables);
 
 		/**
 		 * \brief Loads an asset from a designated path.
 		 * \param request The HTTP request.
 		 * \param response The HTTP response.
+		 * \param assets The cache of the web files.
 		 * \param path The path of the asset.
 		 * \return true, when the asset could be loaded, false otherwise.
 		 */
 		bool loadAssetByPath(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response,
-		                     const std::string& path);
+		                     AssetCache& assets, const std::string& path);
 
 		/**
 		 * \brief Loads an asset from a designated path by extracting the path from the request.
 		 * \param request The HTTP request.
 		 * \param response The HTTP response.
+		 * \param assets The cache of the web files.
 		 * \return true, when the asset could be loaded, false otherwise.
 		 */
-		bool loadAsset(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response);
+		bool loadAsset(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response,
+		               AssetCache& assets);
 
 		/**
 		 * \brief Logins the user, if the credentials are right.
@@ -283,12 +288,56 @@ namespace Burst
 
 		/**
 		 * \brief Sends back the current mining info of the local miner instance.
+		 * The response is served from a cache and answered with 304 if the If-None-Match
+		 * header matches the ETag of the current mining info.
 		 * \param request The HTTP request.
 		 * \param response The HTTP response.
 		 * \param miner The miner instance, from which the mining info is gathered and send.
 		 */
 		void miningInfo(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response,
 			Miner& miner);
+
+		/**
+		 * \brief Sends back the timeline of a round as JSON.
+		 * The timeline of the current round is live, older ones are loaded from the database.
+		 * \param request The HTTP request.
+		 * \param response The HTTP response.
+		 * \param miner The miner instance, that recorded the timeline.
+		 * \param blockheight The height of the round.
+		 */
+		void roundTimeline(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response,
+			Miner& miner, Poco::UInt64 blockheight);
+
+		/**
+		 * \brief Sends back the read throughput baselines of all devices and the throughput history.
+		 * The number of rounds in the history can be set by the query parameter "rounds" (default 100).
+		 * \param request The HTTP request.
+		 * \param response The HTTP response.
+		 * \param miner The miner instance, that collected the throughputs.
+		 */
+		void diskHealth(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response,
+			Miner& miner);
+
+		/**
+		 * \brief Streams one page of the mining history as JSON, the newest entry first.
+		 * The page starts below the query parameter "cursor" and has at most "limit" entries (default 100, max 1000).
+		 * The response contains the cursor of the next page, if there could be more entries.
+		 * \param request The HTTP request.
+		 * \param response The HTTP response.
+		 * \param miner The miner instance, that holds the history.
+		 * \param daily If true, the compacted days are sent, otherwise the raw blocks.
+		 */
+		void history(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response,
+			Miner& miner, bool daily);
+
+		/**
+		 * \brief Sends back all metrics in the Prometheus text format.
+		 * \param request The HTTP request.
+		 * \param response The HTTP response.
+		 * \param server The server instance, which counts the proxied submissions.
+		 */
+		void metrics(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response,
+			MinerServer& server);
 	
 		/**
 		 * \brief Processes setting changes from a POST request.
@@ -0,0 +1,114 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "WebsocketBroadcaster.hpp"
+#include <algorithm>
+#include <iterator>
+
+Burst::WebsocketQueue::WebsocketQueue(const size_t capacity)
+	: capacity_{std::max<size_t>(capacity, 1)}
+{}
+
+void Burst::WebsocketQueue::push(WebsocketMessagePtr message)
+{
+	{
+		std::lock_guard<std::mutex> lock{mutex_};
+
+		auto coalesced = false;
+
+		// progress updates are only interesting in their newest state;
+		// the newest one goes to the tail, so it is never sent before a message that was queued after the old one
+		if (!message->key.empty())
+		{
+			const auto iter = std::find_if(queue_.begin(), queue_.end(), [&](const WebsocketMessagePtr& queued)
+			{
+				return queued->key == message->key;
+			});
+
+			if (iter != queue_.end())
+			{
+				queue_.erase(iter);
+				coalesced = true;
+			}
+		}
+
+		if (!coalesced && queue_.size() >= capacity_)
+		{
+			queue_.pop_front();
+			++dropped_;
+		}
+
+		queue_.emplace_back(std::move(message));
+	}
+
+	condition_.notify_one();
+}
+
+bool Burst::WebsocketQueue::pop(std::vector<WebsocketMessagePtr>& messages, const std::chrono::milliseconds timeout)
+{
+	std::unique_lock<std::mutex> lock{mutex_};
+
+	if (queue_.empty())
+		condition_.wait_for(lock, timeout, [this]() { return !queue_.empty(); });
+
+	if (queue_.empty())
+		return false;
+
+	std::move(queue_.begin(), queue_.end(), std::back_inserter(messages));
+	queue_.clear();
+	return true;
+}
+
+Poco::UInt64 Burst::WebsocketQueue::getDropped() const
+{
+	std::lock_guard<std::mutex> lock{mutex_};
+	return dropped_;
+}
+
+std::shared_ptr<Burst::WebsocketQueue> Burst::WebsocketBroadcaster::subscribe(const size_t capacity)
+{
+	auto queue = std::make_shared<WebsocketQueue>(capacity);
+	std::lock_guard<std::mutex> lock{mutex_};
+	clients_.emplace_back(queue);
+	return queue;
+}
+
+void Burst::WebsocketBroadcaster::unsubscribe(const std::shared_ptr<WebsocketQueue>& queue)
+{
+	std::lock_guard<std::mutex> lock{mutex_};
+	clients_.erase(std::remove(clients_.begin(), clients_.end(), queue), clients_.end());
+}
+
+void Burst::WebsocketBroadcaster::broadcast(WebsocketMessagePtr message)
+{
+	std::lock_guard<std::mutex> lock{mutex_};
+
+	for (auto& client : clients_)
+		client->push(message);
+}
+
+void Burst::WebsocketBroadcaster::broadcast(std::string data, std::string key)
+{
+	auto message = std::make_shared<WebsocketMessage>();
+	message->key = std::move(key);
+	message->data = std::move(data);
+	broadcast(std::move(message));
+}
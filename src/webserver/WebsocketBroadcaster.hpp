@@ -0,0 +1,116 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <Poco/Types.h>
+
+namespace Burst
+{
+	/**
+	 * \brief A serialized websocket message.
+	 * It is created once per broadcast and shared by the queues of all clients.
+	 */
+	struct WebsocketMessage
+	{
+		// a queued message is replaced by a newer one with the same key, an empty key is never replaced
+		std::string key;
+		std::string data;
+	};
+
+	using WebsocketMessagePtr = std::shared_ptr<const WebsocketMessage>;
+
+	/**
+	 * \brief The bounded send queue of one websocket client.
+	 * Pushing never waits for the client, only the connection thread drains the queue and sends the frames.
+	 */
+	class WebsocketQueue
+	{
+	public:
+		explicit WebsocketQueue(size_t capacity);
+
+		/**
+		 * \brief Queues a message.
+		 * If a message with the same key is still queued, it is replaced.
+		 * If the queue is full, the oldest message is dropped.
+		 * \param message The message.
+		 */
+		void push(WebsocketMessagePtr message);
+
+		/**
+		 * \brief Takes all queued messages.
+		 * \param messages The messages are appended to this vector.
+		 * \param timeout The maximum time to wait, if the queue is empty.
+		 * \return true, if at least one message was taken.
+		 */
+		bool pop(std::vector<WebsocketMessagePtr>& messages, std::chrono::milliseconds timeout);
+
+		Poco::UInt64 getDropped() const;
+
+	private:
+		size_t capacity_;
+		std::deque<WebsocketMessagePtr> queue_;
+		Poco::UInt64 dropped_ = 0;
+		mutable std::mutex mutex_;
+		std::condition_variable condition_;
+	};
+
+	/**
+	 * \brief Sends messages to all connected websocket clients.
+	 * Every client has its own queue, so a slow client only loses its own messages
+	 * and never blocks the broadcasting thread or the other clients.
+	 */
+	class WebsocketBroadcaster
+	{
+	public:
+		/**
+		 * \brief Registers a new client.
+		 * \param capacity The maximum number of queued messages of the client.
+		 * \return The queue of the client.
+		 */
+		std::shared_ptr<WebsocketQueue> subscribe(size_t capacity = 256);
+		void unsubscribe(const std::shared_ptr<WebsocketQueue>& queue);
+
+		/**
+		 * \brief Queues a message for all clients.
+		 * \param message The message, that is shared by all queues.
+		 */
+		void broadcast(WebsocketMessagePtr message);
+
+		/**
+		 * \brief Serializes the data once and queues it for all clients.
+		 * \param data The data.
+		 * \param key Queued messages with the same (non-empty) key are replaced.
+		 */
+		void broadcast(std::string data, std::string key = "");
+
+	private:
+		std::vector<std::shared_ptr<WebsocketQueue>> clients_;
+		mutable std::mutex mutex_;
+	};
+}
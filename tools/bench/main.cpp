@@ -0,0 +1,292 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+// Micro benchmarks for the hot paths of the miner.
+//
+// They link the sources of the miner, but run without a config, plot files or network.
+// Every benchmark, that gets an argument, runs once and prints its results.
+//
+// Usage:
+//   creepMinerBench [--log=<calls>] [--deadline=<submitters>] [--parse=<responses>]
+//
+//   --log       the cost of one log call on the calling thread,
+//               synchronous and through the message dispatcher
+//   --deadline  the deadline store with concurrent submitters,
+//               while the progress and the web UI entries are updated
+//   --parse     the cost of parsing one mining info and one nonce confirmation,
+//               with the field extractor and the full JSON parser
+
+#include "logging/MinerLogger.hpp"
+#include "logging/Message.hpp"
+#include "mining/MinerData.hpp"
+#include "network/JsonFieldExtractor.hpp"
+#include "wallet/Account.hpp"
+#include <Poco/JSON/Parser.h>
+#include <Poco/NumberParser.h>
+#include <Poco/TemporaryFile.h>
+#include <Poco/FileChannel.h>
+#include <Poco/FormattingChannel.h>
+#include <Poco/PatternFormatter.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct Options
+	{
+		Poco::UInt64 logCalls = 0;
+		Poco::UInt64 deadlineSubmitters = 0;
+		Poco::UInt64 parseResponses = 0;
+	};
+
+	std::string getArgument(const std::string& argument, const std::string& name)
+	{
+		const auto prefix = "--" + name + "=";
+
+		if (argument.compare(0, prefix.size(), prefix) == 0)
+			return argument.substr(prefix.size());
+
+		return "";
+	}
+
+	bool parseOptions(const int argc, const char* argv[], Options& options)
+	{
+		for (auto i = 1; i < argc; ++i)
+		{
+			const std::string argument = argv[i];
+			std::string value;
+
+			if (!(value = getArgument(argument, "log")).empty())
+				options.logCalls = std::max<Poco::UInt64>(Poco::NumberParser::parseUnsigned64(value), 1);
+			else if (!(value = getArgument(argument, "deadline")).empty())
+				options.deadlineSubmitters = std::max<Poco::UInt64>(Poco::NumberParser::parseUnsigned64(value), 1);
+			else if (!(value = getArgument(argument, "parse")).empty())
+				options.parseResponses = std::max<Poco::UInt64>(Poco::NumberParser::parseUnsigned64(value), 1);
+			else
+			{
+				std::cerr << "Unknown argument: " << argument << std::endl;
+				return false;
+			}
+		}
+
+		if (options.logCalls == 0 && options.deadlineSubmitters == 0 && options.parseResponses == 0)
+		{
+			std::cerr << "Usage: creepMinerBench [--log=<calls>] [--deadline=<submitters>] [--parse=<responses>]" << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	void runLogBenchmark(const Poco::UInt64 calls)
+	{
+		using namespace Poco;
+
+		// a logger that formats and writes like the logfile, but into a temporary file
+		const TemporaryFile file;
+		const AutoPtr<FileChannel> fileChannel{new FileChannel{file.path()}};
+		const AutoPtr<PatternFormatter> pattern{new PatternFormatter{"%d.%m.%Y %H:%M:%S (%I, %U, %u, %p): %t"}};
+		const AutoPtr<FormattingChannel> formatter{new FormattingChannel{pattern, fileChannel}};
+
+		const auto logger = &Logger::get("logBenchmark");
+		logger->setChannel(formatter);
+		logger->setLevel(Poco::Message::PRIO_TRACE);
+
+		const auto measure = [&]()
+		{
+			const auto start = std::chrono::steady_clock::now();
+
+			for (Poco::UInt64 i = 0; i < calls; ++i)
+				log_debug(logger, "Benchmark message %Lu of %Lu", i, calls);
+
+			const auto end = std::chrono::steady_clock::now();
+			return std::chrono::duration<double, std::nano>(end - start).count() / std::max<Poco::UInt64>(calls, 1);
+		};
+
+		Burst::Message::stopDispatcher();
+		const auto synchronous = measure();
+
+		Burst::Message::startDispatcher();
+		Burst::Message::setOverflowPolicy(Burst::LogOverflowPolicy::Block);
+		const auto asyncBlock = measure();
+		Burst::Message::flush();
+
+		Burst::Message::setOverflowPolicy(Burst::LogOverflowPolicy::Drop);
+		const auto asyncDrop = measure();
+		Burst::Message::flush();
+
+		std::cout << "Cost of one log call on the calling thread (" << calls << " calls)" << std::endl
+			<< "\tsynchronous:           " << synchronous << " ns" << std::endl
+			<< "\tasynchronous (block):  " << asyncBlock << " ns" << std::endl
+			<< "\tasynchronous (drop):   " << asyncDrop << " ns" << std::endl;
+
+		logger->setChannel(nullptr);
+		fileChannel->close();
+	}
+
+	void runDeadlineBenchmark(const Poco::UInt64 submitters)
+	{
+		using namespace Burst;
+
+		// like a proxy with many downstream miners, that submit for many accounts
+		constexpr Poco::UInt64 submissions = 20000;
+		constexpr Poco::UInt64 accounts = 1000;
+
+		BlockData block{1, 1, std::string(64, '0')};
+		std::vector<std::shared_ptr<Account>> accountList;
+
+		for (Poco::UInt64 i = 0; i < accounts; ++i)
+			accountList.emplace_back(std::make_shared<Account>(i + 1));
+
+		std::atomic<bool> done{false};
+		Poco::UInt64 uiCalls = 0;
+
+		// the progress sampler and the web UI compete with the submitters
+		std::thread ui{[&]()
+		{
+			while (!done)
+			{
+				block.setProgress(50.f, 50.f, 1);
+				block.forEntries([](const Poco::JSON::Object&) { return true; });
+				block.getBestDeadline();
+				++uiCalls;
+			}
+		}};
+
+		std::vector<std::thread> submitterThreads;
+		const auto start = std::chrono::steady_clock::now();
+
+		for (Poco::UInt64 i = 0; i < submitters; ++i)
+			submitterThreads.emplace_back([&, i]()
+			{
+				std::mt19937_64 random{i};
+
+				for (Poco::UInt64 j = 0; j < submissions; ++j)
+					block.addDeadlineIfBest({random(), random() % 1000000 + 1, accountList[random() % accounts], 1, "benchmark"});
+			});
+
+		for (auto& thread : submitterThreads)
+			thread.join();
+
+		const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		done = true;
+		ui.join();
+
+		const auto total = submitters * submissions;
+
+		std::cout << "Deadline store with " << submitters << " submitters (" << total << " submissions, " << accounts << " accounts)" << std::endl
+			<< "\tsubmissions/s:         " << static_cast<Poco::UInt64>(total / seconds) << std::endl
+			<< "\tper submission:        " << seconds * 1e9 / total << " ns" << std::endl
+			<< "\tprogress/UI updates:   " << uiCalls << std::endl;
+	}
+
+	void runParseBenchmark(const Poco::UInt64 responses)
+	{
+		using namespace Burst;
+
+		// responses like the ones of a pool, the fields are the ones the miner reads
+		const std::string miningInfo = R"({"generationSignature":"9821beb3b34d9a3b30127c05f8d1e9006f8a02f565a3572145134bbe34d37a76",)"
+			R"("baseTarget":"54650","requestProcessingTime":0,"height":"502789","targetDeadline":31536000})";
+		const std::string confirmation = R"({"result":"success","deadline":1234567,"requestProcessingTime":1})";
+
+		Poco::UInt64 checksum = 0;
+
+		const auto measure = [responses](const std::function<void()>& parse)
+		{
+			const auto start = std::chrono::steady_clock::now();
+
+			for (Poco::UInt64 i = 0; i < responses; ++i)
+				parse();
+
+			return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / responses;
+		};
+
+		const auto extractMiningInfo = measure([&]()
+		{
+			const JsonFieldExtractor extractor{miningInfo};
+			std::string gensig;
+			Poco::UInt64 height = 0, baseTarget = 0, targetDeadline = 0;
+			extractor.getString("generationSignature", gensig);
+			extractor.getUnsigned("height", height);
+			extractor.getUnsigned("baseTarget", baseTarget);
+			extractor.getUnsigned("targetDeadline", targetDeadline);
+			checksum += height + baseTarget + targetDeadline + gensig.size();
+		});
+
+		const auto parseMiningInfo = measure([&]()
+		{
+			Poco::JSON::Parser parser;
+			const auto root = parser.parse(miningInfo).extract<Poco::JSON::Object::Ptr>();
+			const auto gensig = root->get("generationSignature").convert<std::string>();
+			checksum += root->get("height").convert<Poco::UInt64>() + root->get("baseTarget").convert<Poco::UInt64>() +
+				root->get("targetDeadline").convert<Poco::UInt64>() + gensig.size();
+		});
+
+		const auto extractConfirmation = measure([&]()
+		{
+			const JsonFieldExtractor extractor{confirmation};
+			Poco::UInt64 deadline = 0;
+			extractor.getUnsigned("deadline", deadline);
+			checksum += deadline;
+		});
+
+		const auto parseConfirmation = measure([&]()
+		{
+			Poco::JSON::Parser parser;
+			const auto root = parser.parse(confirmation).extract<Poco::JSON::Object::Ptr>();
+			checksum += root->get("deadline").convert<Poco::UInt64>();
+		});
+
+		std::cout << "Cost of parsing one response (" << responses << " responses, checksum " << checksum << ")" << std::endl
+			<< "\tmining info, extractor:    " << extractMiningInfo << " ns" << std::endl
+			<< "\tmining info, JSON parser:  " << parseMiningInfo << " ns" << std::endl
+			<< "\tconfirmation, extractor:   " << extractConfirmation << " ns" << std::endl
+			<< "\tconfirmation, JSON parser: " << parseConfirmation << " ns" << std::endl;
+	}
+}
+
+int main(const int argc, const char* argv[])
+{
+	Options options;
+
+	if (!parseOptions(argc, argv, options))
+		return 1;
+
+	Burst::MinerLogger::setup();
+
+	if (options.logCalls > 0)
+		runLogBenchmark(options.logCalls);
+
+	if (options.deadlineSubmitters > 0)
+		runDeadlineBenchmark(options.deadlineSubmitters);
+
+	if (options.parseResponses > 0)
+		runParseBenchmark(options.parseResponses);
+
+	Burst::Message::stopDispatcher();
+	return 0;
+}
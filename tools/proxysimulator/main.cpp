@@ -0,0 +1,490 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+// Load test tool for the proxy mode of the miner.
+//
+// It starts a mock pool with configurable latency, error rate and block time
+// and a swarm of simulated downstream miners, that poll the mining info and submit
+// nonces against a running creepMiner webserver.
+//
+// The miner under test has to use the mock pool as its pool and mining info url, e.g.
+// "urls" : { "submission" : "http://127.0.0.1:8125", "miningInfo" : "http://127.0.0.1:8125" }
+// and needs a running webserver (webserver.start = true).
+//
+// Usage:
+//   proxySimulator --proxy=127.0.0.1:8124 --pool-port=8125 --miners=100 --duration=300
+//                  [--accounts=10] [--pool-latency=200] [--pool-error-rate=0.01]
+//                  [--block-time=240] [--poll-interval=3000] [--submissions=5]
+//                  [--proxy-pid=<pid of the miner>]
+
+#include <Poco/Net/HTTPServer.h>
+#include <Poco/Net/HTTPServerParams.h>
+#include <Poco/Net/HTTPRequestHandler.h>
+#include <Poco/Net/HTTPRequestHandlerFactory.h>
+#include <Poco/Net/HTTPServerRequest.h>
+#include <Poco/Net/HTTPServerResponse.h>
+#include <Poco/Net/HTTPClientSession.h>
+#include <Poco/Net/HTTPRequest.h>
+#include <Poco/Net/HTTPResponse.h>
+#include <Poco/Net/ServerSocket.h>
+#include <Poco/NumberParser.h>
+#include <Poco/StreamCopier.h>
+#include <Poco/Format.h>
+#include <Poco/URI.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	struct Options
+	{
+		std::string proxyHost = "127.0.0.1";
+		Poco::UInt16 proxyPort = 8124;
+		Poco::UInt16 poolPort = 8125;
+		unsigned miners = 50;
+		unsigned accounts = 10;
+		unsigned duration = 120;
+		unsigned poolLatency = 200;
+		double poolErrorRate = 0.01;
+		unsigned blockTime = 240;
+		unsigned pollInterval = 3000;
+		unsigned submissions = 5;
+		int proxyPid = 0;
+	};
+
+	std::string getArgument(const std::string& argument, const std::string& name)
+	{
+		const auto prefix = "--" + name + "=";
+
+		if (argument.compare(0, prefix.size(), prefix) == 0)
+			return argument.substr(prefix.size());
+
+		return "";
+	}
+
+	bool parseOptions(const int argc, const char* argv[], Options& options)
+	{
+		for (auto i = 1; i < argc; ++i)
+		{
+			const std::string argument = argv[i];
+			std::string value;
+
+			if (!(value = getArgument(argument, "proxy")).empty())
+			{
+				const auto colon = value.find(':');
+				options.proxyHost = value.substr(0, colon);
+
+				if (colon != std::string::npos)
+					options.proxyPort = static_cast<Poco::UInt16>(Poco::NumberParser::parseUnsigned(value.substr(colon + 1)));
+			}
+			else if (!(value = getArgument(argument, "pool-port")).empty())
+				options.poolPort = static_cast<Poco::UInt16>(Poco::NumberParser::parseUnsigned(value));
+			else if (!(value = getArgument(argument, "miners")).empty())
+				options.miners = Poco::NumberParser::parseUnsigned(value);
+			else if (!(value = getArgument(argument, "accounts")).empty())
+				options.accounts = std::max(1u, Poco::NumberParser::parseUnsigned(value));
+			else if (!(value = getArgument(argument, "duration")).empty())
+				options.duration = Poco::NumberParser::parseUnsigned(value);
+			else if (!(value = getArgument(argument, "pool-latency")).empty())
+				options.poolLatency = Poco::NumberParser::parseUnsigned(value);
+			else if (!(value = getArgument(argument, "pool-error-rate")).empty())
+				options.poolErrorRate = Poco::NumberParser::parseFloat(value);
+			else if (!(value = getArgument(argument, "block-time")).empty())
+				options.blockTime = std::max(1u, Poco::NumberParser::parseUnsigned(value));
+			else if (!(value = getArgument(argument, "poll-interval")).empty())
+				options.pollInterval = Poco::NumberParser::parseUnsigned(value);
+			else if (!(value = getArgument(argument, "submissions")).empty())
+				options.submissions = Poco::NumberParser::parseUnsigned(value);
+			else if (!(value = getArgument(argument, "proxy-pid")).empty())
+				options.proxyPid = Poco::NumberParser::parse(value);
+			else
+			{
+				std::cerr << "Unknown argument: " << argument << std::endl;
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/**
+	 * \brief The state of the simulated blockchain, shared by the mock pool.
+	 */
+	class MockChain
+	{
+	public:
+		MockChain(const unsigned blockTime)
+			: blockTime_{blockTime}, start_{Clock::now()}
+		{}
+
+		Poco::UInt64 getHeight() const
+		{
+			const auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(Clock::now() - start_).count();
+			return startHeight + static_cast<Poco::UInt64>(elapsed) / blockTime_;
+		}
+
+		std::string getGensig(const Poco::UInt64 height) const
+		{
+			std::mt19937_64 random{height};
+			std::string gensig;
+
+			for (auto i = 0; i < 4; ++i)
+				gensig += Poco::format("%016LX", static_cast<Poco::UInt64>(random()));
+
+			return gensig;
+		}
+
+		static constexpr Poco::UInt64 startHeight = 500000;
+		static constexpr Poco::UInt64 baseTarget = 70312;
+
+	private:
+		unsigned blockTime_;
+		Clock::time_point start_;
+	};
+
+	constexpr Poco::UInt64 MockChain::startHeight;
+	constexpr Poco::UInt64 MockChain::baseTarget;
+
+	struct PoolCounters
+	{
+		std::atomic<Poco::UInt64> miningInfo{0};
+		std::atomic<Poco::UInt64> submissions{0};
+		std::atomic<Poco::UInt64> errors{0};
+	};
+
+	class MockPoolHandler : public Poco::Net::HTTPRequestHandler
+	{
+	public:
+		MockPoolHandler(const MockChain& chain, PoolCounters& counters, const Options& options)
+			: chain_{chain}, counters_{counters}, options_{options}
+		{}
+
+		void handleRequest(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response) override
+		{
+			Poco::URI uri{request.getURI()};
+			std::map<std::string, std::string> parameters;
+
+			for (const auto& parameter : uri.getQueryParameters())
+				parameters[parameter.first] = parameter.second;
+
+			std::string body;
+			const auto height = chain_.getHeight();
+
+			if (parameters["requestType"] == "getMiningInfo")
+			{
+				++counters_.miningInfo;
+				body = Poco::format(R"({"generationSignature":"%s","baseTarget":"%Lu","height":"%Lu","targetDeadline":31536000})",
+					chain_.getGensig(height), MockChain::baseTarget, height);
+			}
+			else if (parameters["requestType"] == "submitNonce")
+			{
+				++counters_.submissions;
+
+				thread_local std::mt19937 random{std::random_device{}()};
+				std::uniform_real_distribution<double> chance{0., 1.};
+
+				std::this_thread::sleep_for(std::chrono::milliseconds(options_.poolLatency));
+
+				if (chance(random) < options_.poolErrorRate)
+				{
+					++counters_.errors;
+					body = R"({"errorCode":"1000","errorDescription":"Simulated pool error"})";
+				}
+				else if (parameters["blockheight"] != std::to_string(height))
+					body = R"({"errorCode":"1005","errorDescription":"Submitted on wrong height"})";
+				else
+					body = Poco::format(R"({"result":"success","deadline":%s})", request.get("X-Deadline", "0"));
+			}
+			else
+			{
+				response.setStatusAndReason(Poco::Net::HTTPResponse::HTTP_NOT_FOUND);
+				response.setContentLength(0);
+				response.send();
+				return;
+			}
+
+			response.setContentType("application/json");
+			response.setContentLength(body.size());
+			response.send() << body;
+		}
+
+	private:
+		const MockChain& chain_;
+		PoolCounters& counters_;
+		const Options& options_;
+	};
+
+	class MockPoolFactory : public Poco::Net::HTTPRequestHandlerFactory
+	{
+	public:
+		MockPoolFactory(const MockChain& chain, PoolCounters& counters, const Options& options)
+			: chain_{chain}, counters_{counters}, options_{options}
+		{}
+
+		Poco::Net::HTTPRequestHandler* createRequestHandler(const Poco::Net::HTTPServerRequest&) override
+		{
+			return new MockPoolHandler{chain_, counters_, options_};
+		}
+
+	private:
+		const MockChain& chain_;
+		PoolCounters& counters_;
+		const Options& options_;
+	};
+
+	struct MinerStats
+	{
+		std::vector<double> miningInfoLatencies;
+		std::vector<double> submitLatencies;
+		Poco::UInt64 errors = 0;
+		Poco::UInt64 notModified = 0;
+	};
+
+	/**
+	 * \brief A simulated downstream miner.
+	 * Polls the mining info and submits a few, mostly improving deadlines per block,
+	 * spread over the first half of the block time like a real miner does.
+	 */
+	void runMiner(const unsigned id, const Options& options, const std::atomic<bool>& running, MinerStats& stats)
+	{
+		std::mt19937_64 random{id * 7919ull + 1};
+		std::uniform_int_distribution<Poco::UInt64> nonceDistribution;
+		std::uniform_int_distribution<Poco::UInt64> deadlineDistribution{1, 10000000};
+		const auto accountId = 10000000000000000000ull + id % options.accounts;
+
+		Poco::Net::HTTPClientSession session{options.proxyHost, options.proxyPort};
+		session.setKeepAlive(true);
+
+		Poco::UInt64 height = 0;
+		Poco::UInt64 bestDeadline = 0;
+		unsigned submitted = 0;
+		std::string etag;
+		auto blockStart = Clock::now();
+		auto nextPoll = Clock::now();
+		auto nextSubmit = Clock::now();
+
+		const auto request = [&](Poco::Net::HTTPRequest& httpRequest, std::vector<double>& latencies, std::string& body) -> int
+		{
+			const auto start = Clock::now();
+
+			try
+			{
+				session.sendRequest(httpRequest);
+				Poco::Net::HTTPResponse response;
+				auto& stream = session.receiveResponse(response);
+				body.clear();
+				Poco::StreamCopier::copyToString(stream, body);
+				latencies.emplace_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+				if (response.has("ETag"))
+					etag = response.get("ETag");
+
+				return response.getStatus();
+			}
+			catch (const Poco::Exception&)
+			{
+				++stats.errors;
+				session.reset();
+				return 0;
+			}
+		};
+
+		while (running)
+		{
+			const auto now = Clock::now();
+			std::string body;
+
+			if (now >= nextPoll)
+			{
+				Poco::Net::HTTPRequest httpRequest{Poco::Net::HTTPRequest::HTTP_GET, "/burst?requestType=getMiningInfo",
+					Poco::Net::HTTPRequest::HTTP_1_1};
+
+				if (!etag.empty())
+					httpRequest.set("If-None-Match", etag);
+
+				const auto status = request(httpRequest, stats.miningInfoLatencies, body);
+
+				if (status == Poco::Net::HTTPResponse::HTTP_NOT_MODIFIED)
+					++stats.notModified;
+				else if (status == Poco::Net::HTTPResponse::HTTP_OK)
+				{
+					const auto heightPos = body.find("\"height\"");
+
+					if (heightPos != std::string::npos)
+					{
+						const auto begin = body.find_first_of("0123456789", heightPos);
+						const auto end = body.find_first_not_of("0123456789", begin);
+						const auto newHeight = Poco::NumberParser::parseUnsigned64(body.substr(begin, end - begin));
+
+						if (newHeight != height)
+						{
+							height = newHeight;
+							bestDeadline = 0;
+							submitted = 0;
+							blockStart = now;
+							nextSubmit = now;
+						}
+					}
+				}
+				else
+					++stats.errors;
+
+				nextPoll = now + std::chrono::milliseconds(options.pollInterval);
+			}
+
+			if (height != 0 && submitted < options.submissions && now >= nextSubmit)
+			{
+				auto deadline = deadlineDistribution(random);
+
+				// most of the time a miner only submits better deadlines
+				if (bestDeadline != 0 && deadline > bestDeadline && random() % 4 != 0)
+					deadline = bestDeadline / 2 + 1;
+
+				bestDeadline = bestDeadline == 0 ? deadline : std::min(bestDeadline, deadline);
+
+				const auto path = Poco::format("/burst?requestType=submitNonce&accountId=%Lu&nonce=%Lu&blockheight=%Lu",
+					accountId, nonceDistribution(random), height);
+
+				Poco::Net::HTTPRequest httpRequest{Poco::Net::HTTPRequest::HTTP_POST, path, Poco::Net::HTTPRequest::HTTP_1_1};
+				httpRequest.set("X-Deadline", std::to_string(deadline));
+				httpRequest.set("X-Capacity", "10240");
+				httpRequest.set("X-Miner", "proxySimulator");
+				httpRequest.set("X-Worker", Poco::format("miner-%u", id));
+				httpRequest.setContentLength(0);
+
+				if (request(httpRequest, stats.submitLatencies, body) != Poco::Net::HTTPResponse::HTTP_OK)
+					++stats.errors;
+
+				++submitted;
+
+				const auto spread = options.blockTime * 500 / std::max(1u, options.submissions);
+				nextSubmit = blockStart + std::chrono::milliseconds(submitted * spread + random() % std::max(1u, spread));
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+	}
+
+	double percentile(std::vector<double>& values, const double p)
+	{
+		if (values.empty())
+			return 0.;
+
+		const auto index = static_cast<size_t>(p * static_cast<double>(values.size() - 1));
+		std::nth_element(values.begin(), values.begin() + index, values.end());
+		return values[index];
+	}
+
+	Poco::UInt64 getResidentMemory(const int pid)
+	{
+		std::ifstream status{Poco::format("/proc/%d/status", pid)};
+		std::string line;
+
+		while (std::getline(status, line))
+			if (line.compare(0, 6, "VmRSS:") == 0)
+				return Poco::NumberParser::parseUnsigned64(line.substr(line.find_first_of("0123456789"),
+					line.find(" kB") - line.find_first_of("0123456789")));
+
+		return 0;
+	}
+}
+
+int main(const int argc, const char* argv[])
+{
+	Options options;
+
+	if (!parseOptions(argc, argv, options))
+		return 1;
+
+	MockChain chain{options.blockTime};
+	PoolCounters poolCounters;
+
+	Poco::Net::HTTPServer pool{new MockPoolFactory{chain, poolCounters, options},
+		Poco::Net::ServerSocket{options.poolPort}, new Poco::Net::HTTPServerParams};
+	pool.start();
+
+	std::cout << Poco::format("Mock pool listening on port %hu, %u miners against %s:%hu for %u seconds",
+		options.poolPort, options.miners, options.proxyHost, options.proxyPort, options.duration) << std::endl;
+
+	std::atomic<bool> running{true};
+	std::vector<MinerStats> stats(options.miners);
+	std::vector<std::thread> miners;
+
+	for (unsigned i = 0; i < options.miners; ++i)
+		miners.emplace_back(runMiner, i, std::cref(options), std::cref(running), std::ref(stats[i]));
+
+	Poco::UInt64 peakMemory = 0;
+	const auto start = Clock::now();
+
+	while (Clock::now() - start < std::chrono::seconds(options.duration))
+	{
+		std::this_thread::sleep_for(std::chrono::seconds(1));
+
+		if (options.proxyPid != 0)
+			peakMemory = std::max(peakMemory, getResidentMemory(options.proxyPid));
+	}
+
+	running = false;
+
+	for (auto& miner : miners)
+		miner.join();
+
+	pool.stop();
+
+	const auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	std::vector<double> miningInfoLatencies, submitLatencies;
+	Poco::UInt64 errors = 0, notModified = 0;
+
+	for (auto& minerStats : stats)
+	{
+		miningInfoLatencies.insert(miningInfoLatencies.end(), minerStats.miningInfoLatencies.begin(), minerStats.miningInfoLatencies.end());
+		submitLatencies.insert(submitLatencies.end(), minerStats.submitLatencies.begin(), minerStats.submitLatencies.end());
+		errors += minerStats.errors;
+		notModified += minerStats.notModified;
+	}
+
+	const auto requests = miningInfoLatencies.size() + submitLatencies.size();
+
+	std::cout << std::string(50, '-') << std::endl
+		<< Poco::format("requests/s          %.1f (%z requests, %Lu errors)", requests / seconds, requests, errors) << std::endl
+		<< Poco::format("getMiningInfo       %z requests, %Lu not modified, p50 %.2f ms, p99 %.2f ms",
+			miningInfoLatencies.size(), notModified, percentile(miningInfoLatencies, .5), percentile(miningInfoLatencies, .99)) << std::endl
+		<< Poco::format("submitNonce         %z requests, p50 %.2f ms, p99 %.2f ms",
+			submitLatencies.size(), percentile(submitLatencies, .5), percentile(submitLatencies, .99)) << std::endl
+		<< Poco::format("upstream            %Lu getMiningInfo, %Lu submitNonce (%Lu simulated errors)",
+			poolCounters.miningInfo.load(), poolCounters.submissions.load(), poolCounters.errors.load()) << std::endl;
+
+	if (options.proxyPid != 0)
+		std::cout << Poco::format("proxy memory        %Lu kB peak resident", peakMemory) << std::endl;
+
+	std::cout << std::string(50, '-') << std::endl;
+	return 0;
+}